@@ -0,0 +1,462 @@
+#ifndef DUNE_BATCHED_CG_SOLVER_HH
+#define DUNE_BATCHED_CG_SOLVER_HH
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+#include "dune/istl/solver.hh"
+
+#include "mixins/eps.hh"
+#include "mixins/maxSteps.hh"
+#include "mixins/relativeAccuracy.hh"
+
+namespace Dune
+{
+  namespace BatchedCGSpec
+  {
+    //! Per-lane scalars, i.e. one value for each of the W systems.
+    template <class real_type, std::size_t W>
+    using LaneArray = std::array<real_type,W>;
+
+    /**
+     * @brief W vectors of dimension n in structure-of-arrays layout.
+     *
+     * Component i of all lanes is stored contiguously, such that loops over the lanes vectorize.
+     */
+    template <class real_type, std::size_t W>
+    class BatchVector
+    {
+    public:
+      using field_type = real_type;
+      static constexpr std::size_t lanes = W;
+
+      explicit BatchVector(std::size_t n = 0)
+        : n_(n), data_(n*W, real_type(0))
+      {}
+
+      //! @return dimension n of each vector
+      std::size_t size() const
+      {
+        return n_;
+      }
+
+      //! Change dimension, invalidates all entries.
+      void resize(std::size_t n)
+      {
+        n_ = n;
+        data_.resize(n*W);
+      }
+
+      //! @return pointer to the W lane values of component i
+      real_type* operator[](std::size_t i)
+      {
+        return &data_[i*W];
+      }
+
+      //! @return pointer to the W lane values of component i
+      const real_type* operator[](std::size_t i) const
+      {
+        return &data_[i*W];
+      }
+
+      //! Copy v, which provides v[i], into the given lane.
+      template <class Vector>
+      void setLane(std::size_t lane, const Vector& v)
+      {
+        assert( lane < W );
+        for( std::size_t i = 0; i < n_; ++i )
+          data_[i*W+lane] = v[i];
+      }
+
+      //! Copy the given lane into v, which provides v[i].
+      template <class Vector>
+      void getLane(std::size_t lane, Vector& v) const
+      {
+        assert( lane < W );
+        for( std::size_t i = 0; i < n_; ++i )
+          v[i] = data_[i*W+lane];
+      }
+
+    private:
+      std::size_t n_;
+      std::vector<real_type> data_;
+    };
+
+
+    //! @cond
+    namespace Detail
+    {
+      template <class real_type, std::size_t W>
+      LaneArray<real_type,W> dot(const BatchVector<real_type,W>& x, const BatchVector<real_type,W>& y)
+      {
+        auto result = LaneArray<real_type,W>{};
+        for( std::size_t i = 0; i < x.size(); ++i )
+        {
+          const auto* xi = x[i];
+          const auto* yi = y[i];
+          for( std::size_t w = 0; w < W; ++w )
+            result[w] += xi[w]*yi[w];
+        }
+        return result;
+      }
+
+      /// y += alpha*x, lane-wise
+      template <class real_type, std::size_t W>
+      void axpy(const LaneArray<real_type,W>& alpha, const BatchVector<real_type,W>& x, BatchVector<real_type,W>& y)
+      {
+        for( std::size_t i = 0; i < x.size(); ++i )
+        {
+          const auto* xi = x[i];
+          auto* yi = y[i];
+          for( std::size_t w = 0; w < W; ++w )
+            yi[w] += alpha[w]*xi[w];
+        }
+      }
+
+      /// y = x + beta*y, lane-wise
+      template <class real_type, std::size_t W>
+      void xpby(const BatchVector<real_type,W>& x, const LaneArray<real_type,W>& beta, BatchVector<real_type,W>& y)
+      {
+        for( std::size_t i = 0; i < x.size(); ++i )
+        {
+          const auto* xi = x[i];
+          auto* yi = y[i];
+          for( std::size_t w = 0; w < W; ++w )
+            yi[w] = xi[w] + beta[w]*yi[w];
+        }
+      }
+    }
+    //! @endcond
+
+
+    /**
+     * @brief W dense \f$n\times n\f$ matrices, stored in structure-of-arrays layout.
+     *
+     * Entry (i,j) of all lanes is stored contiguously, such that apply() vectorizes over the lanes.
+     */
+    template <class real_type, std::size_t W>
+    class BatchedMatrixOperator
+    {
+    public:
+      using domain_type = BatchVector<real_type,W>;
+      using range_type = BatchVector<real_type,W>;
+
+      explicit BatchedMatrixOperator(std::size_t n)
+        : n_(n), data_(n*n*W, real_type(0))
+      {}
+
+      //! Copy matrix A, which provides A[i][j], into the given lane.
+      template <class Matrix>
+      void setMatrix(std::size_t lane, const Matrix& A)
+      {
+        assert( lane < W );
+        for( std::size_t i = 0; i < n_; ++i )
+          for( std::size_t j = 0; j < n_; ++j )
+            data_[(i*n_+j)*W+lane] = A[i][j];
+      }
+
+      //! @return pointer to the W lane values of entry (i,j)
+      const real_type* entry(std::size_t i, std::size_t j) const
+      {
+        return &data_[(i*n_+j)*W];
+      }
+
+      //! y = Ax, lane-wise
+      void apply(const domain_type& x, range_type& y) const
+      {
+        for( std::size_t i = 0; i < n_; ++i )
+        {
+          auto* yi = y[i];
+          std::fill( yi, yi+W, real_type(0) );
+          for( std::size_t j = 0; j < n_; ++j )
+          {
+            const auto* aij = entry(i,j);
+            const auto* xj = x[j];
+            for( std::size_t w = 0; w < W; ++w )
+              yi[w] += aij[w]*xj[w];
+          }
+        }
+      }
+
+      //! @return dimension n
+      std::size_t size() const
+      {
+        return n_;
+      }
+
+    private:
+      std::size_t n_;
+      std::vector<real_type> data_;
+    };
+
+
+    //! Identity as preconditioner for BatchedCGSolver.
+    class BatchedIdentityPreconditioner
+    {
+    public:
+      template <class Vector>
+      void apply(Vector& v, const Vector& d) const
+      {
+        v = d;
+      }
+    };
+
+
+    //! Jacobi preconditioner for BatchedMatrixOperator.
+    template <class real_type, std::size_t W>
+    class BatchedJacobiPreconditioner
+    {
+    public:
+      explicit BatchedJacobiPreconditioner(const BatchedMatrixOperator<real_type,W>& A)
+        : inverseDiagonal_(A.size())
+      {
+        for( std::size_t i = 0; i < A.size(); ++i )
+          for( std::size_t w = 0; w < W; ++w )
+            inverseDiagonal_[i][w] = 1/A.entry(i,i)[w];
+      }
+
+      void apply(BatchVector<real_type,W>& v, const BatchVector<real_type,W>& d) const
+      {
+        for( std::size_t i = 0; i < d.size(); ++i )
+        {
+          const auto* di = d[i];
+          const auto* Di = inverseDiagonal_[i];
+          auto* vi = v[i];
+          for( std::size_t w = 0; w < W; ++w )
+            vi[w] = Di[w]*di[w];
+        }
+      }
+
+    private:
+      BatchVector<real_type,W> inverseDiagonal_;
+    };
+
+
+    //! Cache object for the batched conjugate gradient method, analogous to CGSpec::Cache with per-lane scalars.
+    template <class real_type, std::size_t W>
+    struct Cache
+    {
+      using Vector = BatchVector<real_type,W>;
+
+      Cache( Vector& x0, Vector& b0, Vector& Pr_, Vector& dx_, Vector& Adx_ )
+        : x(x0), r(b0), Pr(Pr_), dx(dx_), Adx(Adx_)
+      {}
+
+      /// Compute the initial residual, lanes with vanishing residual are inactive from the start.
+      template <class Operator>
+      void reset(const Operator& A)
+      {
+        A.apply(x,Adx);
+        for( std::size_t i = 0; i < r.size(); ++i )
+          for( std::size_t w = 0; w < W; ++w )
+            r[i][w] -= Adx[i][w];
+
+        auto residualNorm2 = Detail::dot(r,r);
+        for( std::size_t w = 0; w < W; ++w )
+        {
+          using std::sqrt;
+          residualNorm[w] = initialResidualNorm[w] = sqrt(residualNorm2[w]);
+          active[w] = residualNorm[w] > 0;
+          iterations[w] = 0;
+        }
+        alpha.fill(0);
+        beta.fill(0);
+        firstStep = true;
+      }
+
+      Vector &x, &r, &Pr, &dx, &Adx;
+      LaneArray<real_type,W> alpha = {}, beta = {}, sigma = {}, dxAdx = {}, residualNorm = {}, initialResidualNorm = {};
+      std::array<bool,W> active = {};
+      std::array<unsigned,W> iterations = {};
+      bool firstStep = true;
+    };
+
+
+    //! Apply preconditioner.
+    class ApplyPreconditioner
+    {
+    public:
+      template <class Cache, class Preconditioner>
+      void operator()( Cache& cache, const Preconditioner& P ) const
+      {
+        P.apply( cache.Pr, cache.r );
+      }
+    };
+
+
+    //! Compute search directions, converged lanes are not updated.
+    class SearchDirection
+    {
+    public:
+      template <class Cache, class Operator>
+      void operator()( Cache& cache, const Operator& A ) const
+      {
+        auto newSigma = Detail::dot( cache.r, cache.Pr );
+        for( std::size_t w = 0; w < newSigma.size(); ++w )
+        {
+          using std::abs;
+          newSigma[w] = abs(newSigma[w]);
+          cache.beta[w] = ( cache.firstStep || !cache.active[w] ) ? 0 : newSigma[w]/cache.sigma[w];
+        }
+        cache.sigma = newSigma;
+        Detail::xpby( cache.Pr, cache.beta, cache.dx );
+        cache.firstStep = false;
+
+        A.apply( cache.dx, cache.Adx );
+        cache.dxAdx = Detail::dot( cache.dx, cache.Adx );
+      }
+    };
+
+
+    //! Compute scaling of the search directions, vanishes for converged lanes.
+    class Scaling
+    {
+    public:
+      template <class Cache>
+      void operator()( Cache& cache ) const
+      {
+        for( std::size_t w = 0; w < cache.alpha.size(); ++w )
+          cache.alpha[w] = ( cache.active[w] && cache.dxAdx[w] > 0 ) ? cache.sigma[w]/cache.dxAdx[w] : 0;
+      }
+    };
+
+
+    //! Update iterates and residuals.
+    class UpdateIterate
+    {
+    public:
+      template <class Cache>
+      void operator()( Cache& cache ) const
+      {
+        Detail::axpy( cache.alpha, cache.dx, cache.x );
+        auto minusAlpha = cache.alpha;
+        for( auto& a : minusAlpha )
+          a = -a;
+        Detail::axpy( minusAlpha, cache.Adx, cache.r );
+
+        auto residualNorm2 = Detail::dot( cache.r, cache.r );
+        for( std::size_t w = 0; w < residualNorm2.size(); ++w )
+        {
+          using std::sqrt;
+          if( !cache.active[w] )
+            continue;
+          ++cache.iterations[w];
+          cache.residualNorm[w] = sqrt( residualNorm2[w] );
+        }
+      }
+    };
+  }
+
+
+  /*!
+    @ingroup ISTL_Solvers
+    @brief Conjugate gradient method for W independent small systems, which are processed simultaneously in SIMD lanes.
+
+    The systems are stored in structure-of-arrays layout (see BatchedCGSpec::BatchVector and BatchedCGSpec::BatchedMatrixOperator).
+    Each lane has its own scaling \f$\alpha\f$ and \f$\beta\f$. Lanes that satisfy the residual-based relative accuracy are masked out,
+    i.e. their iterates are no longer updated, and the iteration stops as soon as all lanes have converged or maxSteps() is reached.
+
+    In contrast to GenericIterativeMethod there is no timer, no type erasure and no per-solve allocation: the temporaries are kept in
+    the solver and reused as long as the dimension does not change.
+
+    @code{.cpp}
+    auto A = BatchedCGSpec::BatchedMatrixOperator<double,8>(n);
+    auto P = BatchedCGSpec::BatchedJacobiPreconditioner<double,8>(A);
+    auto cg = BatchedCGSolver< BatchedCGSpec::BatchedMatrixOperator<double,8>, BatchedCGSpec::BatchedJacobiPreconditioner<double,8> >(A,P,1e-10);
+    std::array<InverseOperatorResult,8> res;
+    cg.apply(x,b,res);
+    @endcode
+
+    @tparam Operator batched operator providing apply(x,y)
+    @tparam Preconditioner batched preconditioner providing apply(v,d)
+   */
+  template <class Operator, class Preconditioner,
+            class real_type = typename Operator::domain_type::field_type,
+            std::size_t W = Operator::domain_type::lanes>
+  class BatchedCGSolver :
+      public Mixin::Eps<real_type>,
+      public Mixin::RelativeAccuracy<real_type>,
+      public Mixin::MaxSteps
+  {
+  public:
+    using Vector = BatchedCGSpec::BatchVector<real_type,W>;
+
+    /*!
+      @param A batched operator, must outlive this object
+      @param P batched preconditioner, must outlive this object
+      @param accuracy required relative accuracy of the residuals
+      @param maxSteps maximal number of steps
+     */
+    BatchedCGSolver(const Operator& A, const Preconditioner& P, real_type accuracy, unsigned maxSteps = 1000)
+      : Mixin::RelativeAccuracy<real_type>(accuracy),
+        Mixin::MaxSteps(maxSteps),
+        A_(A), P_(P)
+    {}
+
+    /*!
+      @brief Solve the W systems \f$A_wx_w=b_w\f$.
+      @param x initial iterates, overwritten with the solutions
+      @param b right hand sides, overwritten with the residuals
+      @param res statistics for each lane
+     */
+    void apply(Vector& x, Vector& b, std::array<InverseOperatorResult,W>& res)
+    {
+      Pr_.resize(x.size());
+      dx_.resize(x.size());
+      Adx_.resize(x.size());
+      auto cache = BatchedCGSpec::Cache<real_type,W>( x, b, Pr_, dx_, Adx_ );
+      cache.reset(A_);
+
+      using std::max;
+      auto acc = max( this->eps(), this->relativeAccuracy() );
+      updateMask(cache,acc);
+
+      for( auto step = 0u; step < maxSteps() && anyActive(cache); ++step )
+      {
+        applyPreconditioner_( cache, P_ );
+        computeSearchDirection_( cache, A_ );
+        computeScaling_( cache );
+        update_( cache );
+        updateMask(cache,acc);
+      }
+
+      for( std::size_t w = 0; w < W; ++w )
+      {
+        using std::pow;
+        res[w].clear();
+        res[w].iterations = cache.iterations[w];
+        res[w].reduction = cache.initialResidualNorm[w] > 0 ? cache.residualNorm[w]/cache.initialResidualNorm[w] : 0;
+        res[w].conv_rate = cache.iterations[w] > 0 ? pow( res[w].reduction, 1./cache.iterations[w] ) : 0;
+        res[w].converged = !cache.active[w];
+      }
+    }
+
+  private:
+    static void updateMask(BatchedCGSpec::Cache<real_type,W>& cache, real_type acc)
+    {
+      for( std::size_t w = 0; w < W; ++w )
+        if( cache.active[w] && cache.residualNorm[w] < acc*cache.initialResidualNorm[w] )
+          cache.active[w] = false;
+    }
+
+    static bool anyActive(const BatchedCGSpec::Cache<real_type,W>& cache)
+    {
+      return std::any_of( begin(cache.active), end(cache.active), [](bool active) { return active; } );
+    }
+
+    const Operator& A_;
+    const Preconditioner& P_;
+    Vector Pr_, dx_, Adx_;
+
+    BatchedCGSpec::ApplyPreconditioner applyPreconditioner_;
+    BatchedCGSpec::SearchDirection computeSearchDirection_;
+    BatchedCGSpec::Scaling computeScaling_;
+    BatchedCGSpec::UpdateIterate update_;
+  };
+}
+
+#endif // DUNE_BATCHED_CG_SOLVER_HH
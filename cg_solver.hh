@@ -7,6 +7,7 @@
 
 #include "generic_iterative_method.hh"
 #include "generic_step.hh"
+#include "lanczos_tridiagonal_matrix.hh"
 #include "relative_energy_termination_criterion.hh"
 #include "mixins/iterativeRefinements.hh"
 
@@ -36,7 +37,16 @@ namespace Dune
         A->applyscaleadd(-1,x,r);
         P->apply(Pr,r);
         residualNorm = sp->norm ( r );
+        resetCoefficients();
+      }
+
+      /// Reset the coefficients and the recorded Lanczos matrix, such that the next step starts a new Krylov space.
+      void resetCoefficients()
+      {
+        alpha = beta = sigma = dxAdx = -1;
         firstStep = true;
+        if( lanczosRecorder )
+          lanczosRecorder->clear();
       }
 
       Domain& x;
@@ -49,6 +59,7 @@ namespace Dune
       LinearOperator<Domain,Range>* A = nullptr;
       Preconditioner<Domain,Range>* P = nullptr;
       ScalarProduct<Domain>* sp = nullptr;
+      LanczosTridiagonalMatrix<real_type>* lanczosRecorder = nullptr;
     };
 
 
@@ -79,6 +90,7 @@ namespace Dune
       void setCache(Cache* cache)
       {
         cache_ = cache;
+        cache_->lanczosRecorder = recordLanczosMatrix_ ? &lanczos_ : nullptr;
       }
 
       //! @brief Access scaling for the conjugate search direction, i.e. \f$\frac{(r,Pr)}{(\delta x,A\delta x)}\f$
@@ -105,8 +117,54 @@ namespace Dune
         return cache_->residualNorm;
       }
 
+      /**
+       * @brief Record the coefficients of the Lanczos matrix in subsequent solves (see LanczosTridiagonalMatrix).
+       *
+       * The recorded Lanczos matrix remains accessible after the solve and allows to estimate the extreme eigenvalues of the preconditioned
+       * operator, i.e. to assess the quality of a preconditioner or to provide spectral bounds for ChebyshevSemiIterationStep, at negligible cost.
+       * For regularized variants the Lanczos matrix of the regularized operator \f$A+\theta P\f$ is recorded, starting after the last restart.
+       */
+      void enableLanczosRecording()
+      {
+        recordLanczosMatrix_ = true;
+      }
+
+      //! Stop recording the Lanczos matrix.
+      void disableLanczosRecording()
+      {
+        recordLanczosMatrix_ = false;
+      }
+
+      //! @brief Access Lanczos matrix recorded in the last solve.
+      const LanczosTridiagonalMatrix<typename Cache::real_type>& lanczosMatrix() const
+      {
+        return lanczos_;
+      }
+
+      //! @brief Smallest Ritz value of the last solve, estimates the smallest eigenvalue of the preconditioned operator. Requires enableLanczosRecording().
+      double smallestRitzValue() const
+      {
+        return lanczos_.smallestRitzValue();
+      }
+
+      //! @brief Largest Ritz value of the last solve, estimates the largest eigenvalue of the preconditioned operator. Requires enableLanczosRecording().
+      double largestRitzValue() const
+      {
+        return lanczos_.largestRitzValue();
+      }
+
+      //! @brief Estimate of the condition number of the preconditioned operator. Requires enableLanczosRecording().
+      double conditionNumberEstimate() const
+      {
+        return lanczos_.conditionNumber();
+      }
+
     protected:
-      Cache* cache_;
+      Cache* cache_ = nullptr;
+
+    private:
+      LanczosTridiagonalMatrix<typename Cache::real_type> lanczos_ = {};
+      bool recordLanczosMatrix_ = false;
    };
 
     //! Bind second template argument of CG::InterfaceImpl to satisfy the interface of GenericStep.
@@ -208,6 +266,9 @@ namespace Dune
       template < class Cache >
       void operator()( Cache& cache ) const
       {
+        if( cache.lanczosRecorder && cache.alpha > 0 )
+          cache.lanczosRecorder->push_back( cache.alpha, cache.beta );
+
         cache.x.axpy(cache.alpha,cache.dx);
         cache.r.axpy(-cache.alpha,cache.Adx);
       }
@@ -0,0 +1,107 @@
+#ifndef DUNE_CHEBYSHEV_PRECONDITIONER_HH
+#define DUNE_CHEBYSHEV_PRECONDITIONER_HH
+
+#include <dune/common/typetraits.hh>
+#include <dune/istl/preconditioner.hh>
+#include <dune/istl/solvercategory.hh>
+
+#include "chebyshev_semi_iteration.hh"
+
+namespace Dune
+{
+  /**
+   * @ingroup ISTL_Prec
+   * @brief Polynomial preconditioner based on a fixed number of steps of the Chebyshev semi-iteration.
+   *
+   * Each application performs degree() steps of the Chebyshev semi-iteration for \f$Av=d\f$, starting at \f$v=0\f$. For fixed spectral bounds
+   * this is a linear, symmetric and, if the spectral bounds enclose the spectrum of \f$PA\f$, positive definite operator. Thus, it can be used as
+   * preconditioner for the conjugate gradient method (see @cite Gutknecht2002) or as smoother (see ChebyshevSmoother).
+   *
+   * No inner products are evaluated, no termination criterion is checked and all storage of the underlying ChebyshevSemiIterationStep is
+   * reused in subsequent applications.
+   *
+   * @note Spectral bounds must be provided through getStep() (see ChebyshevSemiIterationStep).
+   */
+  template <class Domain, class Range = Domain>
+  class ChebyshevPreconditioner : public Preconditioner<Domain,Range>
+  {
+  public:
+    //! type of the domain space
+    using domain_type = Domain;
+    //! type of the range space
+    using range_type = Range;
+    //! underlying field type
+    using field_type = field_t<Domain>;
+
+    enum { category = SolverCategory::sequential };
+
+    /**
+     * @brief Constructor.
+     *
+     * @param A linear operator
+     * @param P preconditioner (often a Jacobi preconditioner)
+     * @param sp scalar product
+     * @param degree number of steps of the Chebyshev semi-iteration
+     */
+    template <class LinOp, class Prec, class SP>
+    ChebyshevPreconditioner(LinOp& A, Prec& P, SP& sp, unsigned degree)
+      : step_(A,P,sp), degree_(degree)
+    {}
+
+    /**
+     * @brief Constructor.
+     *
+     * @param A linear operator
+     * @param P preconditioner (often a Jacobi preconditioner)
+     * @param degree number of steps of the Chebyshev semi-iteration
+     */
+    template <class LinOp, class Prec>
+    ChebyshevPreconditioner(LinOp& A, Prec& P, unsigned degree)
+      : step_(A,P), degree_(degree)
+    {}
+
+    //! Nothing to do.
+    void pre(Domain&, Range&) override
+    {}
+
+    /**
+     * @brief Apply preconditioner.
+     * @param v approximate solution of \f$Av=d\f$
+     * @param d right hand side
+     */
+    void apply(Domain& v, const Range& d) override
+    {
+      step_.resetWithZeroInitialGuess( v, d );
+      for( auto i = 0u; i < degree_; ++i )
+        step_.compute( v, d );
+    }
+
+    //! Nothing to do.
+    void post(Domain&) override
+    {}
+
+    //! Set number of steps of the Chebyshev semi-iteration.
+    void setDegree(unsigned degree)
+    {
+      degree_ = degree;
+    }
+
+    //! Access number of steps of the Chebyshev semi-iteration.
+    unsigned degree() const
+    {
+      return degree_;
+    }
+
+    //! Access step implementation, i.e. to provide spectral bounds.
+    ChebyshevSemiIterationStep<Domain,Range>& getStep()
+    {
+      return step_;
+    }
+
+  private:
+    ChebyshevSemiIterationStep<Domain,Range> step_;
+    unsigned degree_;
+  };
+}
+
+#endif // DUNE_CHEBYSHEV_PRECONDITIONER_HH
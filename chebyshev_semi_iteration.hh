@@ -2,20 +2,30 @@
 #define DUNE_CHEBYSHEV_SEMI_ITERATION_HH
 
 #include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <limits>
 #include <memory>
 #include <stdexcept>
 #include <string>
+#include <utility>
 
 #include <dune/common/typetraits.hh>
 #include "cg_solver.hh"
+#include "fixed_steps_termination_criterion.hh"
+#include "lanczos_tridiagonal_matrix.hh"
 #include "residual_based_termination_criterion.hh"
+#include "spectral_bounds.hh"
 
 namespace Dune
 {
   /**
    * @brief One step of the Chebyshev semi-iteration.
    *
-   * @note Requires spectral bounds to be provided by one of the methods setSpectum(), setSpectralBounds() or initializeForMassMatrix_TetrahedralQ1Elements().
+   * @note Requires spectral bounds to be provided by one of the methods setSpectum(), setSpectralBounds(), initializeForMassMatrix() or initializeForMassMatrix_TetrahedralQ1Elements(),
+   * or to be estimated automatically after calling enableSpectralBoundsEstimation().
+   * @note Inner products are only evaluated if the residual norm is requested, i.e. in combination with
+   * KrylovTerminationCriterion::FixedSteps no global reductions are performed.
    */
   template < class Domain, class Range = Domain >
   class ChebyshevSemiIterationStep
@@ -73,30 +83,33 @@ namespace Dune
     }
 
     //! Reset internal storage.
-    void reset( Domain& x, Range& b )
+    void reset( Domain& x, const Range& b )
     {
-      if( !initialized_ )
-        throw std::runtime_error("Uninitialized spectral bounds in chebyshev semi-iteration.");
-
-      if( dx_ == nullptr)
-      {
-        dx_ = std::unique_ptr<Domain>( new Domain(x) );
-        Pr_ = std::unique_ptr<Domain>( new Domain(x) );
-        x1_ = std::unique_ptr<Domain>( new Domain(x) );
-        r_ = std::unique_ptr<Range>( new Range(b) );
-      }
+      prepareStorage( x, b );
 
+      *r_ = b;
       A_.applyscaleadd(-1,x,*r_);
-      P_.apply(*Pr_,*r_);
+      restartRecurrence();
+    }
 
-      sigma_ = sp_.dot(*r_,*Pr_);
-      *x1_ *= 0;
-      *dx_ *= 0;
-      step_ = 1;
+    //! Reset internal storage for the initial iterate \f$x=0\f$, saving the application of the linear operator to the initial iterate.
+    void resetWithZeroInitialGuess( Domain& x, const Range& b )
+    {
+      x *= 0;
+      prepareStorage( x, b );
+
+      *r_ = b;
+      restartRecurrence();
     }
 
-    //! Perform one step of the Chebyshev semi-iteration.
-    void compute( Domain& x, Range& b )
+    /**
+     * @brief Perform one step of the Chebyshev semi-iteration.
+     *
+     * Uses the two-term recurrence for the corrections \f$\delta x_k = -\frac{1}{\alpha_k}(Pr_k - \beta_k\delta x_{k-1})\f$
+     * (see @cite Gutknecht2002). All temporaries live in storage that is allocated once in reset(), the iterate is updated
+     * with a single axpy and the residual is updated with a single application of the linear operator.
+     */
+    void compute( Domain& x, const Range& )
     {
       // compute parameters
       if( step_ == 1 )
@@ -114,21 +127,21 @@ namespace Dune
         alpha_ = -( spectralCenter_ + beta_ );
       }
 
-      // update iterate
-      auto oldX = x;
-      x *= spectralCenter_;
-      x.axpy( 1, *Pr_ );
-      x.axpy( beta_, *x1_ );
-      x *= -1/alpha_;
-      *x1_ = oldX;
+      // update correction and iterate
+      *dx_ *= beta_/alpha_;
+      dx_->axpy( -1/alpha_, *Pr_ );
+      x += *dx_;
 
-      // compute residual
-      *r_ = b;
-      A_.applyscaleadd( -1, x, *r_ );
+      // update residual
+      A_.applyscaleadd( -1, *dx_, *r_ );
 
       // apply preconditioner
       P_.apply( *Pr_, *r_ );
-      sigma_ = sp_.dot( *r_, *Pr_ );
+      sigma_ = -1;
+      ++step_;
+
+      if( adaptive_ )
+        adaptSpectralBounds();
     }
 
     std::string name() const
@@ -158,6 +171,68 @@ namespace Dune
       setSpectrum( (a+b)/2 , (std::max(a,b) - std::min(a,b))/2 );
     }
 
+    /**
+     * @brief Provide information about the spectrum.
+     * @param bounds lower and upper bound of the spectrum, i.e. as computed by the functions in namespace SpectralBounds
+     */
+    void setSpectralBounds(const std::pair< real_t<Domain>, real_t<Domain> >& bounds)
+    {
+      setSpectralBounds( bounds.first, bounds.second );
+    }
+
+    /**
+     * @brief Estimate spectral bounds automatically.
+     *
+     * In the next call of reset(), i.e. at the beginning of the next solve, a few steps of the preconditioned conjugate gradient
+     * method are performed, starting with the initial residual. The extreme Ritz values \f$\theta_{min},\theta_{max}\f$ of the associated
+     * Lanczos matrix (see LanczosTridiagonalMatrix) approximate the extreme eigenvalues of the preconditioned operator from the interior
+     * of its spectrum. The spectral bounds are chosen as \f$[\theta_{min}/s,s\theta_{max}]\f$, where \f$s\f$ is a safety factor.
+     *
+     * The computed bounds are stored and used for all subsequent solves with this operator and preconditioner until new bounds are
+     * provided or this function is called again.
+     *
+     * @param steps maximal number of conjugate gradient steps
+     * @param safetyFactor safety factor \f$s\ge 1\f$
+     */
+    void enableSpectralBoundsEstimation(unsigned steps = 10, real_t<Domain> safetyFactor = 1.1)
+    {
+      assert( steps > 0 && safetyFactor >= 1 );
+      spectralEstimationSteps_ = steps;
+      spectralSafetyFactor_ = safetyFactor;
+      initialized_ = false;
+    }
+
+    /**
+     * @brief Adapt spectral bounds during the iteration.
+     *
+     * If the spectrum of the preconditioned operator is contained in the spectral bounds, then the residuals satisfy
+     * \f$\|r_k\|_P\le \|r_0\|_P/T_k(c/\delta)\f$, where \f$T_k\f$ is the Chebyshev polynomial of degree \f$k\f$, \f$c\f$ is the
+     * spectral center and \f$\delta\f$ the spectral radius. If the observed residual reduction is worse than this bound by more than the
+     * given tolerance, the observed convergence rate is used to estimate the distance \f$d\f$ of the dominating eigenvalue to the
+     * spectral center. The Rayleigh quotient of the preconditioned residual decides if this eigenvalue lies above or below the center,
+     * and the corresponding bound is moved to \f$c+sd\f$, resp. \f$(c-d)/s\f$, with safety factor \f$s\f$. Then the recurrence is
+     * restarted at the current iterate.
+     *
+     * @note Requires the evaluation of one inner product per step, which is shared with KrylovTerminationCriterion::ResidualBased, and an
+     * additional application of the linear operator whenever the spectral bounds are adapted.
+     *
+     * @param tolerance tolerance \f$\ge 1\f$ for the deviation of the observed residual reduction from its theoretical bound
+     * @param safetyFactor safety factor \f$s\ge 1\f$ (shared with enableSpectralBoundsEstimation())
+     */
+    void enableAdaptiveSpectralBounds(real_t<Domain> tolerance = 2, real_t<Domain> safetyFactor = 1.1)
+    {
+      assert( tolerance >= 1 && safetyFactor >= 1 );
+      adaptive_ = true;
+      adaptivityTolerance_ = tolerance;
+      spectralSafetyFactor_ = safetyFactor;
+    }
+
+    //! Use fixed spectral bounds.
+    void disableAdaptiveSpectralBounds()
+    {
+      adaptive_ = false;
+    }
+
     /*!
       \brief Sets spectral bounds for the case that \f$A\f$ is a mass matrix and a one-step Jacobi-preconditioner is used.
 
@@ -172,17 +247,174 @@ namespace Dune
       setSpectrum( 0.5 + halfSpectralDiameter , halfSpectralDiameter );
     }
 
-    //! @brief Access norm of residual with respect to the norm induced by the preconditioner, i.e. \f$(r,Pr)\f$, where \f$r=b-Ax\f$.
+    /**
+     * @brief Sets spectral bounds for the case that \f$A\f$ is a mass matrix and a one-step Jacobi-preconditioner is used.
+     *
+     * The bounds are taken from SpectralBounds::massMatrixJacobi().
+     *
+     * @param element finite element used for the discretization
+     */
+    void initializeForMassMatrix(MassMatrixElement element)
+    {
+      auto bounds = SpectralBounds::massMatrixJacobi( element );
+      setSpectralBounds( bounds.first, bounds.second );
+    }
+
+    /**
+     * @brief Access norm of residual with respect to the norm induced by the preconditioner, i.e. \f$\sqrt{(r,Pr)}\f$, where \f$r=b-Ax\f$.
+     *
+     * The required inner product is only evaluated on demand, at most once per step.
+     */
     double residualNorm() const
     {
+      if( sigma_ < 0 )
+        sigma_ = sp_.dot(*r_,*Pr_);
       return sqrt(sigma_);
     }
 
   private:
+    /// Allocate storage and provide spectral bounds.
+    void prepareStorage( const Domain& x, const Range& b )
+    {
+      if( dx_ == nullptr)
+      {
+        dx_ = std::unique_ptr<Domain>( new Domain(x) );
+        Pr_ = std::unique_ptr<Domain>( new Domain(x) );
+        r_ = std::unique_ptr<Range>( new Range(b) );
+      }
+
+      if( !initialized_ && spectralEstimationSteps_ > 0 )
+        computeSpectralBounds( x, b );
+
+      if( !initialized_ && spectralEstimationSteps_ == 0 )
+        throw std::runtime_error("Uninitialized spectral bounds in chebyshev semi-iteration.");
+    }
+
+    /// Start the recurrence with the residual stored in r_.
+    void restartRecurrence()
+    {
+      P_.apply(*Pr_,*r_);
+      sigma_ = -1;
+      restartPolynomial();
+    }
+
+    /// Start the recurrence with the current residual and preconditioned residual.
+    void restartPolynomial()
+    {
+      *dx_ *= 0;
+      step_ = 1;
+
+      if( adaptive_ )
+      {
+        initialResidualNorm_ = residualNorm();
+        // T_{-1} = T_1
+        previousChebyshevValue_ = spectralCenter_/spectralRadius_;
+        chebyshevValue_ = 1;
+      }
+    }
+
+    /// Compare the observed residual reduction with its theoretical bound and adjust spectral bounds if necessary.
+    void adaptSpectralBounds()
+    {
+      if( spectralRadius_ <= 0 || initialResidualNorm_ <= 0 )
+        return;
+
+      using std::max;
+      using std::min;
+      using std::pow;
+      using std::sqrt;
+      const auto scaledCenter = spectralCenter_/spectralRadius_;
+      auto nextChebyshevValue = 2*scaledCenter*chebyshevValue_ - previousChebyshevValue_;
+      previousChebyshevValue_ = chebyshevValue_;
+      chebyshevValue_ = nextChebyshevValue;
+
+      // the theoretical bound is not informative below the maximal attainable accuracy
+      const auto steps = step_ - 1;
+      if( steps < 2 || chebyshevValue_ * std::numeric_limits<real_type>::epsilon() > 1 )
+        return;
+
+      const auto reduction = residualNorm()/initialResidualNorm_;
+      if( reduction * chebyshevValue_ <= adaptivityTolerance_ )
+        return;
+
+      // observed rate = (d+sqrt(d^2-1))/(c+sqrt(c^2-1)) with d, c scaled by the spectral radius
+      const auto g = pow( reduction, real_type(1)/steps ) * ( scaledCenter + sqrt( scaledCenter*scaledCenter - 1 ) );
+      if( g <= 1 )
+        return;
+      const auto distance = spectralRadius_ * ( g + 1/g ) / 2;
+
+      if( APr_ == nullptr )
+        APr_ = std::unique_ptr<Range>( new Range(*r_) );
+      A_.apply( *Pr_, *APr_ );
+      const auto rayleighQuotient = sp_.dot( *Pr_, *APr_ ) / ( residualNorm()*residualNorm() );
+
+      auto lowerBound = spectralCenter_ - spectralRadius_, upperBound = spectralCenter_ + spectralRadius_;
+      if( rayleighQuotient > spectralCenter_ )
+        upperBound = max( upperBound, spectralSafetyFactor_*( spectralCenter_ + distance ) );
+      else
+        lowerBound = ( spectralCenter_ > distance ) ? min( lowerBound, ( spectralCenter_ - distance )/spectralSafetyFactor_ ) : lowerBound/2;
+
+      setSpectralBounds( lowerBound, upperBound );
+      restartPolynomial();
+    }
+
+    /// Estimate spectral bounds from the Lanczos matrix of a few steps of the preconditioned conjugate gradient method.
+    void computeSpectralBounds( const Domain& x, const Range& b )
+    {
+      *r_ = b;
+      A_.applyscaleadd( -1, x, *r_ );
+      P_.apply( *Pr_, *r_ );
+      *dx_ = *Pr_;
+
+      using std::abs;
+      auto sigma = abs( sp_.dot( *r_, *Pr_ ) );
+      // vanishing residual, no information on the spectrum is available. Use arbitrary bounds in this solve and try again in the next one.
+      if( sigma == 0 )
+      {
+        spectralCenter_ = 1;
+        spectralRadius_ = 0;
+        return;
+      }
+
+      const auto minimalSigma = std::numeric_limits<real_type>::epsilon() * sigma;
+      auto Adx = b;
+      real_type beta = 0;
+      LanczosTridiagonalMatrix<real_type> lanczos;
+      for( auto step = 0u; step < spectralEstimationSteps_; ++step )
+      {
+        A_.apply( *dx_, Adx );
+        auto dxAdx = sp_.dot( *dx_, Adx );
+        if( dxAdx <= 0 )
+          throw std::runtime_error("Nonpositive curvature encountered in the estimation of spectral bounds for the chebyshev semi-iteration.");
+
+        auto alpha = sigma/dxAdx;
+        lanczos.push_back( alpha, beta );
+
+        r_->axpy( -alpha, Adx );
+        P_.apply( *Pr_, *r_ );
+        auto newSigma = abs( sp_.dot( *r_, *Pr_ ) );
+        // (numerically) invariant Krylov space, Ritz values are exact
+        if( newSigma < minimalSigma )
+          break;
+
+        beta = newSigma/sigma;
+        sigma = newSigma;
+        *dx_ *= beta;
+        *dx_ += *Pr_;
+      }
+
+      setSpectralBounds( lanczos.smallestRitzValue()/spectralSafetyFactor_, spectralSafetyFactor_*lanczos.largestRitzValue() );
+    }
+
     real_t<Domain> spectralCenter_ = 0., spectralRadius_ = 0.;
-    real_t<Domain> alpha_ = 0., sigma_ = -1, beta_ = 0;
-    std::unique_ptr<Domain> dx_ = nullptr, Pr_ = nullptr, x1_ = nullptr;
-    std::unique_ptr<Range> r_ = nullptr;
+    real_t<Domain> spectralSafetyFactor_ = 1.1;
+    unsigned spectralEstimationSteps_ = 0;
+    real_t<Domain> adaptivityTolerance_ = 2, initialResidualNorm_ = -1, chebyshevValue_ = 1, previousChebyshevValue_ = 1;
+    bool adaptive_ = false;
+    real_t<Domain> alpha_ = 0., beta_ = 0;
+    mutable real_t<Domain> sigma_ = -1;
+    std::unique_ptr<Domain> dx_ = nullptr, Pr_ = nullptr;
+    std::unique_ptr<Range> r_ = nullptr, APr_ = nullptr;
     unsigned step_ = 1;
     bool initialized_ = false;
 
@@ -197,8 +429,8 @@ namespace Dune
    * @ingroup ISTL_Solvers
    * @brief Preconditioned chebyshev semi-iteration.
    *
-   * Standard implementation based on a three-term recurrence and explicit computation of the residuals to avoid
-   * accumulation of round of errors.
+   * Implementation based on the two-term recurrence for the corrections and recursively updated residuals, which
+   * keeps the gap between true and updated residual small (see @cite Gutknecht2002).
    *
    * If spectral bounds are available, then the Chebyshev semi-iteration, with a fixed size of steps, provides a linear preconditioner (see @cite Gutknecht2002).
    *
@@ -206,6 +438,17 @@ namespace Dune
    */
   template <class Domain, class Range=Domain>
   using ChebyshevSemiIteration = GenericIterativeMethod< ChebyshevSemiIterationStep<Domain,Range>, KrylovTerminationCriterion::ResidualBased< real_t<Domain> > >;
+
+
+  /**
+   * @ingroup ISTL_Solvers
+   * @brief Preconditioned chebyshev semi-iteration with a fixed number of steps.
+   *
+   * Performs exactly maxSteps() steps without evaluating any inner products. Thus, it provides a linear preconditioner, resp. a
+   * polynomial of degree maxSteps() in the preconditioned operator, that does not require global reductions.
+   */
+  template <class Domain, class Range=Domain>
+  using FixedStepChebyshevSemiIteration = GenericIterativeMethod< ChebyshevSemiIterationStep<Domain,Range>, KrylovTerminationCriterion::FixedSteps< real_t<Domain> > >;
 }
 
 #endif // DUNE_CHEBYSHEV_SEMI_ITERATION_HH
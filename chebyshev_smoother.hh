@@ -0,0 +1,108 @@
+#ifndef DUNE_CHEBYSHEV_SMOOTHER_HH
+#define DUNE_CHEBYSHEV_SMOOTHER_HH
+
+#include <dune/istl/operators.hh>
+#include <dune/istl/preconditioners.hh>
+#include <dune/istl/solvercategory.hh>
+#include <dune/istl/paamg/smoother.hh>
+
+#include "chebyshev_preconditioner.hh"
+
+namespace Dune
+{
+  /**
+   * @ingroup ISTL_Prec
+   * @brief Jacobi-preconditioned Chebyshev polynomial for assembled matrices, suitable as smoother in algebraic multigrid.
+   *
+   * Spectral bounds of the Jacobi-preconditioned matrix are estimated in the first application
+   * (see ChebyshevSemiIterationStep::enableSpectralBoundsEstimation()) and reused afterwards.
+   *
+   * @tparam M matrix type
+   * @tparam X domain type
+   * @tparam Y range type
+   */
+  template <class M, class X, class Y = X>
+  class ChebyshevSmoother : public Preconditioner<X,Y>
+  {
+  public:
+    //! matrix type
+    using matrix_type = M;
+    //! type of the domain space
+    using domain_type = X;
+    //! type of the range space
+    using range_type = Y;
+    //! underlying field type
+    using field_type = typename X::field_type;
+
+    enum { category = SolverCategory::sequential };
+
+    /**
+     * @brief Constructor.
+     *
+     * @param A matrix
+     * @param degree number of steps of the Chebyshev semi-iteration
+     * @param estimationSteps maximal number of conjugate gradient steps for the estimation of spectral bounds
+     */
+    ChebyshevSmoother(const M& A, unsigned degree, unsigned estimationSteps = 10)
+      : A_(A), jacobi_(A,1,1.), chebyshev_(A_,jacobi_,degree)
+    {
+      chebyshev_.getStep().enableSpectralBoundsEstimation( estimationSteps );
+    }
+
+    /// The Chebyshev preconditioner refers to operator and Jacobi preconditioner of this object, thus copies would refer to the source.
+    ChebyshevSmoother(const ChebyshevSmoother&) = delete;
+    ChebyshevSmoother& operator=(const ChebyshevSmoother&) = delete;
+
+    //! Nothing to do.
+    void pre(X&, Y&) override
+    {}
+
+    //! @copydoc ChebyshevPreconditioner::apply()
+    void apply(X& v, const Y& d) override
+    {
+      chebyshev_.apply( v, d );
+    }
+
+    //! Nothing to do.
+    void post(X&) override
+    {}
+
+    //! Access underlying Chebyshev preconditioner, i.e. to provide spectral bounds.
+    ChebyshevPreconditioner<X,Y>& getPreconditioner()
+    {
+      return chebyshev_;
+    }
+
+  private:
+    MatrixAdapter<M,X,Y> A_;
+    SeqJacobi<M,X,Y> jacobi_;
+    ChebyshevPreconditioner<X,Y> chebyshev_;
+  };
+
+
+  namespace Amg
+  {
+    /**
+     * @brief Construction of ChebyshevSmoother in algebraic multigrid.
+     *
+     * The number of iterations of the smoother arguments is used as the degree of the Chebyshev polynomial.
+     */
+    template <class M, class X, class Y>
+    struct ConstructionTraits< ChebyshevSmoother<M,X,Y> >
+    {
+      using Arguments = DefaultConstructionArgs< ChebyshevSmoother<M,X,Y> >;
+
+      static inline ChebyshevSmoother<M,X,Y>* construct(Arguments& args)
+      {
+        return new ChebyshevSmoother<M,X,Y>( args.getMatrix(), args.getArgs().iterations );
+      }
+
+      static inline void deconstruct(ChebyshevSmoother<M,X,Y>* smoother)
+      {
+        delete smoother;
+      }
+    };
+  }
+}
+
+#endif // DUNE_CHEBYSHEV_SMOOTHER_HH
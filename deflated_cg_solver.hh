@@ -0,0 +1,536 @@
+#ifndef DUNE_DEFLATED_CG_SOLVER_HH
+#define DUNE_DEFLATED_CG_SOLVER_HH
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <dune/common/typetraits.hh>
+#include "cg_solver.hh"
+#include "generic_iterative_method.hh"
+#include "generic_step.hh"
+#include "lanczos_tridiagonal_matrix.hh"
+#include "relative_energy_termination_criterion.hh"
+#include "symmetric_eigenvalue_problem.hh"
+
+namespace Dune
+{
+  /**
+   * @brief Approximately invariant subspace of the preconditioned operator that is recycled over a sequence of solves.
+   *
+   * Stores a basis \f$W\f$ of Ritz vectors of \f$PA\f$ together with \f$AW\f$ and \f$P^{-1}W\f$. At the beginning of each solve \f$AW\f$
+   * and the Galerkin matrix \f$W^TAW\f$ are recomputed for the current operator. \f$P^{-1}W\f$ can not be recomputed. If the preconditioner
+   * changes (see preconditionerChanged()), \f$W\f$ is still used for the projection, but replaced by the Ritz vectors of the next solve. At the end of each solve Ritz vectors are extracted from the
+   * Lanczos matrix of the first steps of the conjugate gradient method and combined with the current basis in a Rayleigh-Ritz procedure
+   * (see @cite Parks2006). The Ritz vectors belonging to the smallest Ritz values form the new basis.
+   */
+  template <class Domain, class Range>
+  class RecycledSubspace
+  {
+  public:
+    using real_type = real_t<Domain>;
+
+    /**
+     * @param maxDimension maximal dimension of the recycled subspace
+     * @param recordedSteps number of conjugate gradient steps used for the extraction of Ritz vectors (if 0, twice the maximal dimension is used)
+     */
+    explicit RecycledSubspace(unsigned maxDimension = 8, unsigned recordedSteps = 0)
+      : maxDimension_(maxDimension),
+        recordedSteps_( recordedSteps > 0 ? recordedSteps : 2*maxDimension )
+    {}
+
+    //! Set maximal dimension of the recycled subspace. A smaller dimension takes effect at the end of the next solve.
+    void setMaxDimension(unsigned maxDimension)
+    {
+      maxDimension_ = maxDimension;
+    }
+
+    //! Maximal dimension of the recycled subspace.
+    unsigned maxDimension() const
+    {
+      return maxDimension_;
+    }
+
+    //! Set number of conjugate gradient steps used for the extraction of Ritz vectors.
+    void setNumberOfRecordedSteps(unsigned recordedSteps)
+    {
+      recordedSteps_ = recordedSteps;
+    }
+
+    //! Number of conjugate gradient steps used for the extraction of Ritz vectors.
+    unsigned numberOfRecordedSteps() const
+    {
+      return recordedSteps_;
+    }
+
+    //! Dimension of the recycled subspace.
+    std::size_t dimension() const
+    {
+      return W_.size();
+    }
+
+    //! Ritz values associated with the basis vectors, in ascending order.
+    const std::vector<real_type>& ritzValues() const
+    {
+      return ritzValues_;
+    }
+
+    //! Discard the recycled subspace, i.e. if the operator changed considerably.
+    void clear()
+    {
+      W_.clear();
+      AW_.clear();
+      MW_.clear();
+      ritzValues_.clear();
+      choleskyFactor_.clear();
+    }
+
+    /**
+     * @brief Discard \f$P^{-1}W\f$, i.e. if the preconditioner has been modified in place.
+     *
+     * Called automatically if a different preconditioner object is passed to prepare().
+     */
+    void preconditionerChanged()
+    {
+      MW_.clear();
+    }
+
+    /**
+     * @brief Recompute \f$AW\f$ and the Cholesky factorization of \f$W^TAW\f$ for the current operator.
+     *
+     * If \f$W^TAW\f$ is not positive definite the subspace is discarded.
+     */
+    void prepare(LinearOperator<Domain,Range>& A, const Preconditioner<Domain,Range>& P, ScalarProduct<Domain>& sp)
+    {
+      if( &P != preconditioner_ )
+      {
+        preconditionerChanged();
+        preconditioner_ = &P;
+      }
+
+      const auto k = dimension();
+      for( std::size_t i = 0; i < k; ++i )
+        A.apply( W_[i], AW_[i] );
+
+      choleskyFactor_.assign( k*k, real_type(0) );
+      for( std::size_t i = 0; i < k; ++i )
+        for( std::size_t j = 0; j <= i; ++j )
+          choleskyFactor_[i*k+j] = sp.dot( W_[i], AW_[j] );
+
+      if( !factorize() )
+        clear();
+    }
+
+    //! Project initial guess, i.e. \f$x\leftarrow x+W(W^TAW)^{-1}W^Tr\f$ and \f$r\leftarrow r-AW(W^TAW)^{-1}W^Tr\f$.
+    void projectInitialGuess(Domain& x, Range& r, ScalarProduct<Domain>& sp) const
+    {
+      if( dimension() == 0 )
+        return;
+
+      for( std::size_t i = 0; i < dimension(); ++i )
+        coefficients_[i] = sp.dot( W_[i], r );
+      solve();
+
+      for( std::size_t i = 0; i < dimension(); ++i )
+      {
+        x.axpy( coefficients_[i], W_[i] );
+        r.axpy( -coefficients_[i], AW_[i] );
+      }
+    }
+
+    //! Make search direction \f$A\f$-orthogonal to \f$W\f$, i.e. \f$\delta x\leftarrow \delta x-W(W^TAW)^{-1}(AW)^TPr\f$.
+    void projectSearchDirection(Domain& dx, const Domain& Pr, ScalarProduct<Domain>& sp) const
+    {
+      if( dimension() == 0 )
+        return;
+
+      for( std::size_t i = 0; i < dimension(); ++i )
+        coefficients_[i] = sp.dot( AW_[i], Pr );
+      solve();
+
+      for( std::size_t i = 0; i < dimension(); ++i )
+        dx.axpy( -coefficients_[i], W_[i] );
+    }
+
+    /**
+     * @brief Extract Ritz vectors from the last solve and update the recycled subspace.
+     *
+     * With the Lanczos vectors \f$u_j=(-1)^jPr_j/\sqrt{(r_j,Pr_j)}\f$ the Ritz vectors of \f$PA\f$ are given by \f$y=\sum_j s_ju_j\f$,
+     * where \f$s\f$ is an eigenvector of the Lanczos matrix. These are combined with \f$W\f$ in a Rayleigh-Ritz procedure with respect
+     * to the inner products \f$(\cdot,A\cdot)\f$ and \f$(\cdot,P^{-1}\cdot)\f$.
+     *
+     * @param lanczos Lanczos matrix of the recorded steps
+     * @param preconditionedResiduals recorded preconditioned residuals \f$Pr_j\f$
+     * @param residuals recorded residuals \f$r_j\f$
+     * @param A linear operator
+     * @param sp scalar product
+     */
+    void update(const LanczosTridiagonalMatrix<real_type>& lanczos,
+                const std::vector<Domain>& preconditionedResiduals, const std::vector<Range>& residuals,
+                LinearOperator<Domain,Range>& A, ScalarProduct<Domain>& sp)
+    {
+      using std::abs;
+      using std::sqrt;
+
+      const auto m = std::min( lanczos.size(), preconditionedResiduals.size() );
+      if( m == 0 || maxDimension_ == 0 )
+        return;
+
+      auto T = std::vector<real_type>( m*m, real_type(0) );
+      for( std::size_t j = 0; j < m; ++j )
+      {
+        T[j*m+j] = lanczos.diagonal(j);
+        if( j+1 < m )
+          T[j*m+j+1] = T[(j+1)*m+j] = lanczos.offDiagonal(j);
+      }
+      auto S = std::vector<real_type>{};
+      symmetricEigenvalueProblem( T, m, &S );
+
+      // without P^{-1}W only the Ritz vectors of the last solve are used
+      const auto recycle = MW_.size() == W_.size();
+      auto Z = recycle ? W_ : std::vector<Domain>{};
+      auto AZ = recycle ? AW_ : std::vector<Range>{};
+      auto MZ = recycle ? MW_ : std::vector<Range>{};
+      for( std::size_t l = 0; l < std::min<std::size_t>( m, maxDimension_ ); ++l )
+      {
+        auto y = preconditionedResiduals[0];
+        y *= 0;
+        auto My = residuals[0];
+        My *= 0;
+        for( std::size_t j = 0; j < m; ++j )
+        {
+          auto scale = ( j%2 == 0 ? 1 : -1 ) * S[j*m+l] / sqrt( abs( sp.dot( residuals[j], preconditionedResiduals[j] ) ) );
+          y.axpy( scale, preconditionedResiduals[j] );
+          My.axpy( scale, residuals[j] );
+        }
+        auto Ay = My;
+        A.apply( y, Ay );
+
+        Z.push_back( std::move(y) );
+        AZ.push_back( std::move(Ay) );
+        MZ.push_back( std::move(My) );
+      }
+
+      rayleighRitz( Z, AZ, MZ, sp );
+    }
+
+  private:
+    /// Select the Ritz vectors for the smallest Ritz values from span(Z).
+    void rayleighRitz(const std::vector<Domain>& Z, const std::vector<Range>& AZ, const std::vector<Range>& MZ, ScalarProduct<Domain>& sp)
+    {
+      using std::sqrt;
+      const auto n = Z.size();
+
+      auto G = std::vector<real_type>( n*n ), F = std::vector<real_type>( n*n );
+      for( std::size_t i = 0; i < n; ++i )
+        for( std::size_t j = 0; j <= i; ++j )
+        {
+          G[i*n+j] = G[j*n+i] = ( sp.dot( Z[i], AZ[j] ) + sp.dot( Z[j], AZ[i] ) ) / 2;
+          F[i*n+j] = F[j*n+i] = ( sp.dot( Z[i], MZ[j] ) + sp.dot( Z[j], MZ[i] ) ) / 2;
+        }
+
+      // basis of span(Z) that is orthonormal with respect to (.,P^{-1}.), discarding nearly linearly dependent directions
+      auto Q = std::vector<real_type>{};
+      auto lambda = symmetricEigenvalueProblem( F, n, &Q );
+      if( !( lambda.back() > 0 ) )
+      {
+        clear();
+        return;
+      }
+      auto basis = std::vector<std::size_t>{};
+      for( std::size_t i = 0; i < n; ++i )
+        if( lambda[i] > sqrt( std::numeric_limits<real_type>::epsilon() ) * lambda.back() )
+          basis.push_back( i );
+      const auto r = basis.size();
+
+      auto B = std::vector<real_type>( n*r );
+      for( std::size_t i = 0; i < n; ++i )
+        for( std::size_t l = 0; l < r; ++l )
+          B[i*r+l] = Q[i*n+basis[l]] / sqrt( lambda[basis[l]] );
+
+      auto C = std::vector<real_type>( r*r, real_type(0) );
+      for( std::size_t k = 0; k < r; ++k )
+        for( std::size_t l = 0; l < r; ++l )
+          for( std::size_t i = 0; i < n; ++i )
+            for( std::size_t j = 0; j < n; ++j )
+              C[k*r+l] += B[i*r+k] * G[i*n+j] * B[j*r+l];
+
+      auto S = std::vector<real_type>{};
+      auto theta = symmetricEigenvalueProblem( C, r, &S );
+
+      const auto k = std::min<std::size_t>( r, maxDimension_ );
+      W_.clear();
+      AW_.clear();
+      MW_.clear();
+      ritzValues_.assign( begin(theta), begin(theta) + k );
+      for( std::size_t l = 0; l < k; ++l )
+      {
+        auto w = Z[0];
+        w *= 0;
+        auto Aw = AZ[0];
+        Aw *= 0;
+        auto Mw = MZ[0];
+        Mw *= 0;
+        for( std::size_t i = 0; i < n; ++i )
+        {
+          real_type x = 0;
+          for( std::size_t j = 0; j < r; ++j )
+            x += B[i*r+j] * S[j*r+l];
+          w.axpy( x, Z[i] );
+          Aw.axpy( x, AZ[i] );
+          Mw.axpy( x, MZ[i] );
+        }
+        W_.push_back( std::move(w) );
+        AW_.push_back( std::move(Aw) );
+        MW_.push_back( std::move(Mw) );
+      }
+    }
+
+    /// In-place Cholesky factorization of the lower triangular part of W^TAW.
+    bool factorize()
+    {
+      using std::sqrt;
+      const auto k = dimension();
+      for( std::size_t j = 0; j < k; ++j )
+      {
+        auto d = choleskyFactor_[j*k+j];
+        for( std::size_t l = 0; l < j; ++l )
+          d -= choleskyFactor_[j*k+l] * choleskyFactor_[j*k+l];
+        if( !( d > 0 ) )
+          return false;
+        choleskyFactor_[j*k+j] = sqrt( d );
+
+        for( std::size_t i = j+1; i < k; ++i )
+        {
+          auto e = choleskyFactor_[i*k+j];
+          for( std::size_t l = 0; l < j; ++l )
+            e -= choleskyFactor_[i*k+l] * choleskyFactor_[j*k+l];
+          choleskyFactor_[i*k+j] = e / choleskyFactor_[j*k+j];
+        }
+      }
+      coefficients_.resize( k );
+      return true;
+    }
+
+    /// Solve (W^TAW) c = coefficients_ in-place.
+    void solve() const
+    {
+      const auto k = dimension();
+      for( std::size_t i = 0; i < k; ++i )
+      {
+        for( std::size_t l = 0; l < i; ++l )
+          coefficients_[i] -= choleskyFactor_[i*k+l] * coefficients_[l];
+        coefficients_[i] /= choleskyFactor_[i*k+i];
+      }
+      for( std::size_t i = k; i-- > 0; )
+      {
+        for( std::size_t l = i+1; l < k; ++l )
+          coefficients_[i] -= choleskyFactor_[l*k+i] * coefficients_[l];
+        coefficients_[i] /= choleskyFactor_[i*k+i];
+      }
+    }
+
+    unsigned maxDimension_, recordedSteps_;
+    const Preconditioner<Domain,Range>* preconditioner_ = nullptr;
+    std::vector<Domain> W_ = {};
+    std::vector<Range> AW_ = {}, MW_ = {};
+    std::vector<real_type> ritzValues_ = {}, choleskyFactor_ = {};
+    mutable std::vector<real_type> coefficients_ = {};
+  };
+
+
+  namespace DCGSpec
+  {
+    //! Cache object for the deflated conjugate gradient method.
+    template <class Domain, class Range>
+    struct Cache : CGSpec::Cache<Domain,Range>
+    {
+      template <class... Args>
+      Cache(Args&&... args)
+        : CGSpec::Cache<Domain,Range>( std::forward<Args>(args)... )
+      {}
+
+      void reset(LinearOperator<Domain,Range>* A_,
+                Preconditioner<Domain,Range>* P_,
+                ScalarProduct<Domain>* sp_)
+      {
+        assert(subspace);
+        this->A = A_;
+        this->P = P_;
+        this->sp = sp_;
+        this->A->applyscaleadd(-1,this->x,this->r);
+        subspace->prepare( *this->A, *this->P, *this->sp );
+        subspace->projectInitialGuess( this->x, this->r, *this->sp );
+        this->P->apply(this->Pr,this->r);
+        this->residualNorm = this->sp->norm( this->r );
+        this->resetCoefficients();
+
+        lanczos.clear();
+        residuals.clear();
+        preconditionedResiduals.clear();
+      }
+
+      RecycledSubspace<Domain,Range>* subspace = nullptr;
+      LanczosTridiagonalMatrix< real_t<Domain> > lanczos = {};
+      std::vector<Range> residuals = {};
+      std::vector<Domain> preconditionedResiduals = {};
+    };
+
+
+    //! @cond
+    class Name
+    {
+    public:
+      std::string name() const
+      {
+        return "Deflated Conjugate Gradients";
+      }
+    };
+    //! @endcond
+
+
+    //! Bind second template argument of CG::InterfaceImpl to satisfy the interface of GenericStep.
+    template <class Domain, class Range>
+    using Interface = CGSpec::InterfaceImpl< Cache<Domain,Range>, Name >;
+
+
+    //! Compute search direction for the deflated conjugate gradient method and record the data for the extraction of Ritz vectors.
+    class SearchDirection
+    {
+    public:
+      template < class Cache >
+      void operator()( Cache& cache) const
+      {
+        if( cache.preconditionedResiduals.size() < cache.subspace->numberOfRecordedSteps() )
+        {
+          cache.residuals.push_back( cache.r );
+          cache.preconditionedResiduals.push_back( cache.Pr );
+        }
+
+        if( cache.firstStep )
+        {
+          cache.dx = cache.Pr;
+          cache.subspace->projectSearchDirection( cache.dx, cache.Pr, *cache.sp );
+          computeInducedStepLength(cache);
+          cache.firstStep = false;
+          return;
+        }
+
+        using std::abs;
+        auto newSigma = abs( cache.sp->dot(cache.r,cache.Pr) );
+        cache.beta = newSigma/cache.sigma;
+        cache.dx *= cache.beta; cache.dx += cache.Pr;
+        cache.subspace->projectSearchDirection( cache.dx, cache.Pr, *cache.sp );
+        cache.sigma = newSigma;
+
+        computeInducedStepLength(cache);
+      }
+
+    private:
+      template < class Cache >
+      void computeInducedStepLength( Cache& cache ) const
+      {
+        cache.A->apply(cache.dx,cache.Adx);
+        cache.dxAdx = cache.sp->dot(cache.dx,cache.Adx);
+      }
+    };
+
+
+    //! Update iterate and record the coefficients of the Lanczos matrix.
+    class UpdateIterate : public CGSpec::UpdateIterate
+    {
+    public:
+      template < class Cache >
+      void operator()( Cache& cache ) const
+      {
+        if( cache.lanczos.size() < cache.preconditionedResiduals.size() && cache.alpha > 0 )
+          cache.lanczos.push_back( cache.alpha, cache.beta );
+        CGSpec::UpdateIterate::operator()( cache );
+      }
+    };
+
+
+    /**
+     * @brief Step implementation for the deflated conjugate gradient method.
+     *
+     * Owns the recycled subspace, which persists over subsequent solves.
+     */
+    template <class Domain, class Range=Domain>
+    class Step :
+        public GenericStep< Domain, Range,
+          CGSpec::ApplyPreconditioner,
+          SearchDirection,
+          CGSpec::Scaling,
+          UpdateIterate,
+          Interface< Domain, Range >
+        >
+    {
+      using Base = GenericStep< Domain, Range, CGSpec::ApplyPreconditioner, SearchDirection, CGSpec::Scaling, UpdateIterate, Interface<Domain,Range> >;
+
+    public:
+      using typename Base::Cache;
+      using Base::Base;
+
+      void setCache( Cache* cache )
+      {
+        cache->subspace = &subspace_;
+        Base::setCache( cache );
+      }
+
+      /*!
+        @brief Update the recycled subspace and post-process final iterate.
+        @param x final iterate
+       */
+      void postProcess(Domain& x)
+      {
+        subspace_.update( this->cache_->lanczos, this->cache_->preconditionedResiduals, this->cache_->residuals,
+                          *this->cache_->A, *this->cache_->sp );
+        Base::postProcess(x);
+      }
+
+      //! Access recycled subspace.
+      RecycledSubspace<Domain,Range>& getRecycledSubspace()
+      {
+        return subspace_;
+      }
+
+      //! Access recycled subspace.
+      const RecycledSubspace<Domain,Range>& getRecycledSubspace() const
+      {
+        return subspace_;
+      }
+
+    private:
+      RecycledSubspace<Domain,Range> subspace_;
+    };
+  }
+
+
+  /*!
+    @ingroup ISTL_Solvers
+    @brief Deflated conjugate gradient method with Krylov subspace recycling (see @cite Saad2000, @cite Parks2006).
+
+    Designed for sequences of linear systems with slowly changing operators, such as in Newton's method or in time stepping schemes.
+    The components of the error in the recycled subspace \f$W\f$ (see RecycledSubspace) are removed by projection of the initial guess,
+    and the search directions are kept \f$A\f$-orthogonal to \f$W\f$. This removes the influence of the smallest eigenvalues of the
+    preconditioned operator on the convergence. The recycled subspace is owned by the step implementation and updated with Ritz vectors at
+    the end of each solve.
+
+    Each step requires \f$\dim(W)\f$ additional inner products and vector updates. Each solve requires \f$\dim(W)\f$ additional applications
+    of the linear operator at its beginning and at most \f$\dim(W)\f$ at its end.
+
+    @tparam Domain domain space \f$X\f$
+    @tparam Range range space \f$Y\f$
+    @tparam TerminationCriterion termination criterion (such as Dune::KrylovTerminationCriterion::ResidualBased or Dune::KrylovTerminationCriterion::RelativeEnergyError (default))
+   */
+  template <class Domain, class Range,
+            template <class> class TerminationCriterion = KrylovTerminationCriterion::RelativeEnergyError>
+  using DCGSolver = GenericIterativeMethod< DCGSpec::Step<Domain,Range> , TerminationCriterion< real_t<Domain> > >;
+}
+
+#endif // DUNE_DEFLATED_CG_SOLVER_HH
@@ -0,0 +1,258 @@
+#ifndef DUNE_FIXED_SIZE_CG_SOLVER_HH
+#define DUNE_FIXED_SIZE_CG_SOLVER_HH
+
+#include <cmath>
+#include <utility>
+
+#include <dune/common/fmatrix.hh>
+#include <dune/common/fvector.hh>
+
+#include "dune/istl/solver.hh"
+
+#include "residual_based_termination_criterion.hh"
+
+namespace Dune
+{
+  namespace FixedSizeCGSpec
+  {
+    //! @cond
+    namespace Detail
+    {
+      /// Call f(i) for i = first,...,last-1 without loop.
+      template <int first, int last>
+      struct Unroll
+      {
+        template <class Functor>
+        static void apply(Functor&& f)
+        {
+          f(first);
+          Unroll<first+1,last>::apply(std::forward<Functor>(f));
+        }
+      };
+
+      template <int last>
+      struct Unroll<last,last>
+      {
+        template <class Functor>
+        static void apply(Functor&&)
+        {}
+      };
+
+      template <class T, int N>
+      T dot(const FieldVector<T,N>& x, const FieldVector<T,N>& y)
+      {
+        auto result = T(0);
+        Unroll<0,N>::apply( [&](int i) { result += x[i]*y[i]; } );
+        return result;
+      }
+
+      /// y += a*x
+      template <class T, int N>
+      void axpy(T a, const FieldVector<T,N>& x, FieldVector<T,N>& y)
+      {
+        Unroll<0,N>::apply( [&](int i) { y[i] += a*x[i]; } );
+      }
+
+      /// y = Ax
+      template <class T, int N>
+      void mv(const FieldMatrix<T,N,N>& A, const FieldVector<T,N>& x, FieldVector<T,N>& y)
+      {
+        Unroll<0,N>::apply( [&](int i)
+        {
+          auto yi = T(0);
+          Unroll<0,N>::apply( [&](int j) { yi += A[i][j]*x[j]; } );
+          y[i] = yi;
+        });
+      }
+    }
+    //! @endcond
+
+
+    //! Identity as preconditioner for FixedSizeCGSolver.
+    class IdentityPreconditioner
+    {
+    public:
+      template <class T, int N>
+      explicit IdentityPreconditioner(const FieldMatrix<T,N,N>&)
+      {}
+
+      template <class T, int N>
+      void apply(FieldVector<T,N>& v, const FieldVector<T,N>& d) const
+      {
+        v = d;
+      }
+    };
+
+
+    //! Jacobi preconditioner for FixedSizeCGSolver.
+    template <class T, int N>
+    class JacobiPreconditioner
+    {
+    public:
+      explicit JacobiPreconditioner(const FieldMatrix<T,N,N>& A)
+      {
+        Detail::Unroll<0,N>::apply( [&](int i) { inverseDiagonal_[i] = 1/A[i][i]; } );
+      }
+
+      void apply(FieldVector<T,N>& v, const FieldVector<T,N>& d) const
+      {
+        Detail::Unroll<0,N>::apply( [&](int i) { v[i] = inverseDiagonal_[i]*d[i]; } );
+      }
+
+    private:
+      FieldVector<T,N> inverseDiagonal_;
+    };
+  }
+
+
+  /*!
+    @ingroup ISTL_Solvers
+    @brief Conjugate gradient method for dense systems of compile-time dimension N.
+
+    Operates on FieldVector<T,N> and FieldMatrix<T,N,N>. All temporaries live on the stack and all vector operations are unrolled at
+    compile time. In contrast to MyCGSolver there is no type erasure of operator and preconditioner, no cache allocation and no
+    observer registration. The existing termination criteria can be used, since the solver provides the same interface as
+    CGSpec::InterfaceImpl (residualNorm(), preconditionedResidualNorm(), alpha() and length()).
+
+    @code{.cpp}
+    auto cg = FixedSizeCGSolver<double,6>(A,KrylovTerminationCriterion::ResidualBased<double>(1e-12));
+    cg.apply(x,b);
+    @endcode
+
+    @tparam T field type
+    @tparam N dimension
+    @tparam TerminationCriterion termination criterion (such as Dune::KrylovTerminationCriterion::ResidualBased (default) or Dune::KrylovTerminationCriterion::RelativeEnergyError)
+    @tparam Preconditioner FixedSizeCGSpec::IdentityPreconditioner (default) or FixedSizeCGSpec::JacobiPreconditioner<T,N>
+   */
+  template <class T, int N,
+            class TerminationCriterion = KrylovTerminationCriterion::ResidualBased< real_t<T> >,
+            class Preconditioner = FixedSizeCGSpec::IdentityPreconditioner>
+  class FixedSizeCGSolver
+  {
+  public:
+    using domain_type = FieldVector<T,N>;
+    using range_type = FieldVector<T,N>;
+    using matrix_type = FieldMatrix<T,N,N>;
+    using real_type = real_t<T>;
+
+    /*!
+      @param A symmetric positive definite matrix, must outlive this object
+      @param terminate termination criterion
+      @param maxSteps maximal number of steps
+     */
+    explicit FixedSizeCGSolver(const matrix_type& A, TerminationCriterion terminate = TerminationCriterion(), unsigned maxSteps = 1000)
+      : A_(A), P_(A), terminate_(std::move(terminate)), maxSteps_(maxSteps)
+    {
+      terminate_.connect(*this);
+    }
+
+    FixedSizeCGSolver(const FixedSizeCGSolver& other)
+      : A_(other.A_), P_(other.P_), terminate_(other.terminate_), maxSteps_(other.maxSteps_)
+    {
+      terminate_.connect(*this);
+    }
+
+    FixedSizeCGSolver& operator=(const FixedSizeCGSolver&) = delete;
+
+    /*!
+      @brief Solve \f$Ax=b\f$.
+      @param x initial iterate
+      @param b right hand side
+      @param res some statistics
+     */
+    void apply(domain_type& x, const range_type& b, InverseOperatorResult& res)
+    {
+      auto r = b;
+      domain_type Pr, dx, Adx;
+      FixedSizeCGSpec::Detail::mv(A_,x,Adx);
+      r -= Adx;
+      P_.apply(Pr,r);
+      sigma_ = FixedSizeCGSpec::Detail::dot(r,Pr);
+      using std::sqrt;
+      residualNorm_ = sqrt( FixedSizeCGSpec::Detail::dot(r,r) );
+      terminate_.init();
+
+      auto step = 1u;
+      for( ; step <= maxSteps_ && sigma_ > 0; ++step )
+      {
+        if( step == 1 )
+          dx = Pr;
+        else
+        {
+          auto newSigma = FixedSizeCGSpec::Detail::dot(r,Pr);
+          auto beta = newSigma/sigma_;
+          dx *= beta;
+          dx += Pr;
+          sigma_ = newSigma;
+        }
+
+        FixedSizeCGSpec::Detail::mv(A_,dx,Adx);
+        dxAdx_ = FixedSizeCGSpec::Detail::dot(dx,Adx);
+        alpha_ = sigma_/dxAdx_;
+
+        FixedSizeCGSpec::Detail::axpy(alpha_,dx,x);
+        FixedSizeCGSpec::Detail::axpy(-alpha_,Adx,r);
+        residualNorm_ = sqrt( FixedSizeCGSpec::Detail::dot(r,r) );
+
+        if( terminate_ )
+          break;
+        P_.apply(Pr,r);
+      }
+
+      terminate_.print(res);
+      res.converged = step <= maxSteps_;
+    }
+
+    //! @brief Solve \f$Ax=b\f$.
+    void apply(domain_type& x, const range_type& b)
+    {
+      InverseOperatorResult res;
+      apply(x,b,res);
+    }
+
+    //! @brief Access norm of the residual \f$\|r\|\f$, where \f$r=b-Ax\f$.
+    real_type residualNorm() const
+    {
+      return residualNorm_;
+    }
+
+    //! @brief Access \f$(r,Pr)\f$.
+    real_type preconditionedResidualNorm() const
+    {
+      return sigma_;
+    }
+
+    //! @brief Access scaling for the conjugate search direction, i.e. \f$\frac{(r,Pr)}{(\delta x,A\delta x)}\f$
+    real_type alpha() const
+    {
+      return alpha_;
+    }
+
+    //! @brief Access length of conjugate search direction with respect to the energy norm, i.e. \f$(\delta x,A\delta x)\f$.
+    real_type length() const
+    {
+      return dxAdx_;
+    }
+
+    //! Set maximal number of steps.
+    void setMaxSteps(unsigned maxSteps)
+    {
+      maxSteps_ = maxSteps;
+    }
+
+    //! Access termination criterion.
+    TerminationCriterion& getTerminationCriterion()
+    {
+      return terminate_;
+    }
+
+  private:
+    const matrix_type& A_;
+    Preconditioner P_;
+    TerminationCriterion terminate_;
+    unsigned maxSteps_;
+    real_type residualNorm_ = 0, sigma_ = 0, alpha_ = 0, dxAdx_ = 0;
+  };
+}
+
+#endif // DUNE_FIXED_SIZE_CG_SOLVER_HH
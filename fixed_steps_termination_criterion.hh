@@ -0,0 +1,76 @@
+#ifndef DUNE_FIXED_STEPS_TERMINATION_CRITERION_HH
+#define DUNE_FIXED_STEPS_TERMINATION_CRITERION_HH
+
+#include <limits>
+
+#include <dune/common/timer.hh>
+
+#include "mixins/maxSteps.hh"
+#include "mixins/relativeAccuracy.hh"
+
+namespace Dune
+{
+  /*! @cond */
+  class InverseOperatorResult;
+  /*! @endcond */
+
+  namespace KrylovTerminationCriterion
+  {
+    /*!
+      @ingroup ISTL_Solvers
+      @brief %Termination criterion that performs a fixed number of steps.
+
+      Terminates after maxSteps() steps, where the number of steps is forwarded from GenericIterativeMethod::setMaxSteps(). Thus, the number of
+      steps is not passed to the constructor but set on the iterative method.
+      No information on the iteration is requested from the step implementation. Thus, steps that evaluate inner products only
+      on demand (such as ChebyshevSemiIterationStep) do not perform any global reductions, i.e. the iterative method
+      acts as a fixed polynomial preconditioner.
+
+      The relative accuracy is only provided to satisfy the interface of GenericIterativeMethod and is ignored.
+     */
+    template <class real_type>
+    class FixedSteps :
+        public Mixin::MaxSteps,
+        public Mixin::RelativeAccuracy<real_type>
+    {
+    public:
+      //! @copydoc ResidualBased::init()
+      void init()
+      {
+        iteration_ = 0;
+        watch.reset();
+        watch.start();
+      }
+
+      //! Nothing to connect, the step implementation is never queried.
+      template <class Step>
+      void connect(Step&&)
+      {}
+
+      //! @copydoc ResidualBased::print()
+      void print(InverseOperatorResult& res)
+      {
+        res.iterations = iteration_;
+        res.elapsed = watch.stop();
+      }
+
+      //! @return true if maxSteps() steps have been performed
+      operator bool()
+      {
+        return ++iteration_ >= maxSteps();
+      }
+
+      //! No error estimate is computed, returns NaN.
+      real_type errorEstimate() const
+      {
+        return std::numeric_limits<real_type>::quiet_NaN();
+      }
+
+    private:
+      unsigned iteration_ = 0;
+      Timer watch = Timer{ false };
+    };
+  }
+}
+
+#endif // DUNE_FIXED_STEPS_TERMINATION_CRITERION_HH
@@ -0,0 +1,235 @@
+#ifndef DUNE_FLEXIBLE_CG_SOLVER_HH
+#define DUNE_FLEXIBLE_CG_SOLVER_HH
+
+#include <cassert>
+#include <cmath>
+#include <string>
+#include <utility>
+
+#include <dune/common/typetraits.hh>
+
+#include "cg_solver.hh"
+#include "generic_iterative_method.hh"
+#include "generic_step.hh"
+#include "relative_energy_termination_criterion.hh"
+
+namespace Dune
+{
+  namespace FlexibleCGSpec
+  {
+    //! Settings of the search directions and statistics of the restarts, persistent across solves.
+    template <class real_type>
+    struct Truncation
+    {
+      /// use the truncated flexible conjugate gradient method FCG(1), i.e. A-orthogonalize against the previous search direction only
+      bool orthogonalize = false;
+      /// restart if \f$|(r_{k+1},P_kr_k)|>\nu(r_{k+1},P_{k+1}r_{k+1})\f$, 0 disables restarts
+      real_type restartThreshold = 0;
+      /// number of restarts in the last solve
+      unsigned restarts = 0;
+
+      /// true if the previous preconditioned residual is required
+      bool requiresPreviousPr() const
+      {
+        return !orthogonalize || restartThreshold > 0;
+      }
+    };
+
+
+    //! Cache object for the flexible conjugate gradient method, additionally stores the previous preconditioned residual.
+    template <class Domain, class Range>
+    struct Cache : CGSpec::Cache<Domain,Range>
+    {
+      Cache( Domain& x0, Range& b0 )
+        : CGSpec::Cache<Domain,Range>( x0, b0 ),
+          previousPr(x0)
+      {}
+
+      void reset(LinearOperator<Domain,Range>* A,
+                Preconditioner<Domain,Range>* P,
+                ScalarProduct<Domain>* sp)
+      {
+        CGSpec::Cache<Domain,Range>::reset(A,P,sp);
+        if( truncation )
+          truncation->restarts = 0;
+      }
+
+      Domain previousPr;
+      Truncation< real_t<Domain> >* truncation = nullptr;
+    };
+
+
+    //! @cond
+    class Name
+    {
+    public:
+      std::string name() const
+      {
+        return "Flexible Conjugate Gradients";
+      }
+    };
+    //! @endcond
+
+
+    //! Extends public interface of GenericStep for the flexible conjugate gradient method.
+    template <class Cache, class Name>
+    class InterfaceImpl : public CGSpec::InterfaceImpl<Cache,Name>
+    {
+      using real_type = typename Cache::real_type;
+
+    public:
+      void setCache(Cache* cache)
+      {
+        CGSpec::InterfaceImpl<Cache,Name>::setCache(cache);
+        cache_->truncation = &truncation_;
+      }
+
+      /**
+       * @brief Use the truncated flexible conjugate gradient method FCG(1) (see @cite Notay2000).
+       *
+       * The new search direction is A-orthogonalized against the previous one, i.e. \f$\beta_k = -\frac{(P_{k+1}r_{k+1},A\delta x_k)}{(\delta x_k,A\delta x_k)}\f$.
+       * Reuses \f$A\delta x_k\f$ and \f$(\delta x_k,A\delta x_k)\f$ and costs the same as the Polak-Ribiere formula. The previous
+       * preconditioned residual is not required, unless restarts are enabled (see enableRestarts()).
+       */
+      void enableTruncation()
+      {
+        truncation_.orthogonalize = true;
+      }
+
+      //! Use the Polak-Ribiere formula (default).
+      void disableTruncation()
+      {
+        truncation_.orthogonalize = false;
+      }
+
+      /**
+       * @brief Restart if consecutive preconditioned residuals lose orthogonality (see @cite Powell1977).
+       *
+       * If \f$|(r_{k+1},P_kr_k)|>\nu(r_{k+1},P_{k+1}r_{k+1})\f$, the new search direction is \f$P_{k+1}r_{k+1}\f$.
+       * Moreover, negative values of \f$\beta\f$ are replaced by zero. Does not require additional scalar products for the
+       * Polak-Ribiere formula and one additional scalar product for FCG(1).
+       *
+       * @param threshold \f$\nu\f$
+       */
+      void enableRestarts(real_type threshold = 0.2)
+      {
+        assert( threshold > 0 );
+        truncation_.restartThreshold = threshold;
+      }
+
+      //! Never restart the recurrence of the search directions (default).
+      void disableRestarts()
+      {
+        truncation_.restartThreshold = 0;
+      }
+
+      //! Number of restarts in the last solve.
+      unsigned restarts() const
+      {
+        return truncation_.restarts;
+      }
+
+    protected:
+      using CGSpec::InterfaceImpl<Cache,Name>::cache_;
+
+    private:
+      Truncation<real_type> truncation_ = {};
+    };
+
+
+    //! Bind second template argument of FlexibleCGSpec::InterfaceImpl to satisfy the interface of GenericStep.
+    template <class Domain, class Range>
+    using Interface = InterfaceImpl< Cache<Domain,Range>, Name >;
+
+
+    /**
+     * @brief Compute search direction with the Polak-Ribiere formula \f$\beta_k = \frac{(r_{k+1},P_{k+1}r_{k+1}-P_kr_k)}{(r_k,P_kr_k)}\f$,
+     * resp. with FCG(1) (see InterfaceImpl::enableTruncation()).
+     *
+     * Both coincide with the Fletcher-Reeves formula of CGSpec::SearchDirection for fixed preconditioners, but retain local orthogonality
+     * if the preconditioner changes between steps (see @cite Notay2000). Both cost one additional scalar product per step.
+     */
+    class SearchDirection
+    {
+    public:
+      template < class Cache >
+      void operator()( Cache& cache ) const
+      {
+        using std::swap;
+        auto requiresPreviousPr = !cache.truncation || cache.truncation->requiresPreviousPr();
+
+        if( cache.firstStep )
+        {
+          cache.dx = cache.Pr;
+          // Pr is overwritten when the preconditioner is applied in the next step
+          if( requiresPreviousPr )
+            swap( cache.previousPr, cache.Pr );
+          computeInducedStepLength(cache);
+          cache.firstStep = false;
+          return;
+        }
+
+        using std::abs;
+        auto newSigma = abs( cache.sp->dot(cache.r,cache.Pr) );
+        auto rPreviousPr = requiresPreviousPr ? cache.sp->dot(cache.r,cache.previousPr) : typename Cache::real_type(0);
+        if( cache.truncation && cache.truncation->orthogonalize )
+          cache.beta = -cache.sp->dot(cache.Pr,cache.Adx)/cache.dxAdx;
+        else
+          cache.beta = ( newSigma - rPreviousPr )/cache.sigma;
+
+        if( cache.truncation && cache.truncation->restartThreshold > 0 &&
+            ( cache.beta < 0 || abs(rPreviousPr) > cache.truncation->restartThreshold * newSigma ) )
+        {
+          cache.beta = 0;
+          ++cache.truncation->restarts;
+        }
+
+        cache.dx *= cache.beta; cache.dx += cache.Pr;
+        if( requiresPreviousPr )
+          swap( cache.previousPr, cache.Pr );
+        cache.sigma = newSigma;
+
+        computeInducedStepLength(cache);
+      }
+
+    private:
+      template < class Cache >
+      void computeInducedStepLength( Cache& cache ) const
+      {
+        cache.A->apply(cache.dx,cache.Adx);
+        cache.dxAdx = cache.sp->dot(cache.dx,cache.Adx);
+      }
+    };
+
+
+    //! Step implementation for the flexible conjugate gradient method.
+    template <class Domain, class Range=Domain>
+    using Step =
+    GenericStep< Domain, Range,
+      CGSpec::ApplyPreconditioner,
+      SearchDirection,
+      CGSpec::Scaling,
+      CGSpec::UpdateIterate,
+      Interface< Domain, Range >
+    >;
+  }
+
+
+  /*!
+    @ingroup ISTL_Solvers
+    @brief Flexible conjugate gradient method for variable or nonlinear preconditioners (see @cite Notay2000).
+
+    Uses the Polak-Ribiere formula for the search directions, i.e. admits preconditioners that are themselves iterative methods, such as
+    the Chebyshev semi-iteration with adaptive number of steps or an inner conjugate gradient method. Stores one additional vector.
+    Optionally, the truncated variant FCG(1) is used instead (see FlexibleCGSpec::InterfaceImpl::enableTruncation()).
+
+    @tparam Domain domain space \f$X\f$
+    @tparam Range range space \f$Y\f$
+    @tparam TerminationCriterion termination criterion (such as Dune::KrylovTerminationCriterion::ResidualBased or Dune::KrylovTerminationCriterion::RelativeEnergyError (default))
+   */
+  template <class Domain, class Range,
+            template <class> class TerminationCriterion = KrylovTerminationCriterion::RelativeEnergyError>
+  using FlexibleCGSolver = GenericIterativeMethod< FlexibleCGSpec::Step<Domain,Range> , TerminationCriterion< real_t<Domain> > >;
+}
+
+#endif // DUNE_FLEXIBLE_CG_SOLVER_HH
@@ -0,0 +1,148 @@
+#ifndef DUNE_FORCING_TERM_HH
+#define DUNE_FORCING_TERM_HH
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <limits>
+
+#include "mixins/minimalAccuracy.hh"
+#include "mixins/relativeAccuracy.hh"
+
+namespace Dune
+{
+  /**
+   * @brief Adaptive forcing terms for inexact Newton methods according to Eisenstat and Walker (choice 2 in @cite Eisenstat1996).
+   *
+   * Given the norms \f$\|F_k\|\f$ of the nonlinear residuals, the relative accuracy of the inner iterative solver in the \f$k\f$-th Newton step is
+   * \f[ \eta_k = \min\left(\eta_{max}, \max\left(\gamma\left(\frac{\|F_k\|}{\|F_{k-1}\|}\right)^\alpha, \gamma\eta_{k-1}^\alpha\right)\right), \f]
+   * where the safeguard \f$\gamma\eta_{k-1}^\alpha\f$ is only used if it exceeds \f$0.1\f$. If a nonlinear tolerance \f$\varepsilon\f$ is set,
+   * oversolving in the last steps is prevented by \f$\eta_k\ge\frac{\varepsilon}{2\|F_k\|}\f$.
+   *
+   * The relaxed accuracy for TRCGSolver (see Mixin::MinimalAccuracy) is set to \f$\min(\eta_{max},\kappa\eta_k)\f$.
+   *
+   * Relative and minimal accuracy are forwarded to connected iterative methods with the observer mechanism of the mixins:
+   * @code{.cpp}
+   * auto forcingTerm = EisenstatWalkerForcingTerm<>{};
+   * forcingTerm.connect(trcg);
+   * while( !converged )
+   * {
+   *   forcingTerm.setNonlinearResidual( F.two_norm() );
+   *   trcg.apply(dx,F);
+   *   ...
+   * }
+   * @endcode
+   */
+  template <class real_type = double>
+  class EisenstatWalkerForcingTerm :
+      public Mixin::RelativeAccuracy<real_type>,
+      public Mixin::MinimalAccuracy<real_type>
+  {
+  public:
+    /**
+     * @param initialForcingTerm forcing term \f$\eta_0\f$ of the first Newton step
+     * @param gamma factor \f$\gamma\in(0,1]\f$
+     * @param alpha exponent \f$\alpha\in(1,2]\f$
+     * @param maxForcingTerm upper bound \f$\eta_{max}<1\f$
+     */
+    explicit EisenstatWalkerForcingTerm(real_type initialForcingTerm = 0.5, real_type gamma = 0.9, real_type alpha = 2, real_type maxForcingTerm = 0.9)
+      : Mixin::RelativeAccuracy<real_type>( initialForcingTerm ),
+        Mixin::MinimalAccuracy<real_type>( std::min( maxForcingTerm, 10*initialForcingTerm ) ),
+        initialForcingTerm_( initialForcingTerm ), gamma_( gamma ), alpha_( alpha ), maxForcingTerm_( maxForcingTerm )
+    {
+      assert( initialForcingTerm > 0 && initialForcingTerm <= maxForcingTerm );
+      assert( gamma > 0 && gamma <= 1 );
+      assert( alpha > 1 && alpha <= 2 );
+      assert( maxForcingTerm < 1 );
+    }
+
+    /**
+     * @brief Connect iterative method, i.e. GenericIterativeMethod.
+     *
+     * The current forcing term is set immediately, subsequent changes are forwarded automatically.
+     *
+     * @param method iterative method, must outlive this object or be disconnected with disconnect()
+     */
+    template <class IterativeMethod>
+    void connect(IterativeMethod& method)
+    {
+      Optional::Mixin::Attach< Mixin::RelativeAccuracy<real_type>, Mixin::MinimalAccuracy<real_type> >::apply( *this, method );
+      // notify attached methods, methods without minimal accuracy are not attached to it
+      this->setRelativeAccuracy( this->relativeAccuracy() );
+      this->setMinimalAccuracy( this->minimalAccuracy() );
+    }
+
+    //! Disconnect iterative method.
+    template <class IterativeMethod>
+    void disconnect(IterativeMethod& method)
+    {
+      Optional::Mixin::Detach< Mixin::RelativeAccuracy<real_type>, Mixin::MinimalAccuracy<real_type> >::apply( *this, method );
+    }
+
+    /**
+     * @brief Update the forcing term for the next Newton step.
+     * @param residualNorm norm \f$\|F_k\|\f$ of the nonlinear residual at the current iterate
+     */
+    void setNonlinearResidual(real_type residualNorm)
+    {
+      assert( residualNorm >= 0 );
+      using std::max;
+      using std::min;
+      using std::pow;
+
+      auto eta = initialForcingTerm_;
+      if( lastResidualNorm_ > 0 )
+      {
+        eta = gamma_ * pow( residualNorm / lastResidualNorm_, alpha_ );
+        auto safeguard = gamma_ * pow( this->relativeAccuracy(), alpha_ );
+        if( safeguard > real_type(0.1) )
+          eta = max( eta, safeguard );
+      }
+      if( nonlinearTolerance_ > 0 && residualNorm > 0 )
+        eta = max( eta, nonlinearTolerance_ / ( 2 * residualNorm ) );
+      eta = min( maxForcingTerm_, max( eta, std::numeric_limits<real_type>::epsilon() ) );
+
+      lastResidualNorm_ = residualNorm;
+      this->setRelativeAccuracy( eta );
+      this->setMinimalAccuracy( min( maxForcingTerm_, minimalAccuracyFactor_ * eta ) );
+    }
+
+    //! Start a new nonlinear solve, i.e. the next forcing term is the initial one.
+    void reset()
+    {
+      lastResidualNorm_ = 0;
+    }
+
+    /**
+     * @brief Set the tolerance \f$\varepsilon\f$ of the nonlinear solver to avoid oversolving in the last Newton steps.
+     * @param tolerance absolute tolerance for the norm of the nonlinear residual (default = 0, i.e. no safeguard)
+     */
+    void setNonlinearTolerance(real_type tolerance)
+    {
+      assert( tolerance >= 0 );
+      nonlinearTolerance_ = tolerance;
+    }
+
+    /**
+     * @brief Set factor \f$\kappa\f$ of the minimal accuracy.
+     * @param factor ratio of minimal and relative accuracy (default = 10)
+     */
+    void setMinimalAccuracyFactor(real_type factor)
+    {
+      assert( factor >= 1 );
+      minimalAccuracyFactor_ = factor;
+    }
+
+    //! Access the current forcing term \f$\eta_k\f$.
+    real_type forcingTerm() const
+    {
+      return this->relativeAccuracy();
+    }
+
+  private:
+    real_type initialForcingTerm_, gamma_, alpha_, maxForcingTerm_;
+    real_type minimalAccuracyFactor_ = 10, nonlinearTolerance_ = 0, lastResidualNorm_ = 0;
+  };
+}
+
+#endif // DUNE_FORCING_TERM_HH
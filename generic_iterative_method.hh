@@ -2,8 +2,13 @@
 #define DUNE_GENERIC_ITERATIVE_METHOD_HH
 
 #include <functional>
+#include <cassert>
+#include <chrono>
+#include <cstddef>
+#include <limits>
 #include <memory>
 #include <ostream>
+#include <stdexcept>
 #include <utility>
 
 #include "dune/common/typetraits.hh"
@@ -11,19 +16,73 @@
 
 #include "optional.hh"
 #include "mixins.hh"
+#include "solver_control.hh"
+#include "termination_criterion_combinators.hh"
 
 #include "fglue/TMP/bind.hh"
 #include "fglue/TMP/createMissingBaseClasses.hh"
 
 namespace Dune
 {
+  /**
+   * @brief Data that GenericIterativeMethod stores for restarts, i.e. for the regularized conjugate gradient methods.
+   */
+  enum class RestartStorage
+  {
+    /// Store initial guess and right hand side (default).
+    InitialGuessAndRightHandSide,
+    /// Store only the right hand side. Declares that the initial guesses passed to apply() are zero (only checked in debug mode), restarts start from zero.
+    ZeroInitialGuess,
+    /// Store nothing. Restarts throw, i.e. use this with RCGSpec::InterfaceImpl::enableInPlaceRegularization().
+    None
+  };
+
+  //! Reason for the termination of GenericIterativeMethod::apply().
+  enum class SolverStatus
+  {
+    /// The termination criterion is satisfied.
+    Converged,
+    /// The maximal number of steps has been performed.
+    MaxStepsReached,
+    /// The termination criterion detected stagnation (see KrylovTerminationCriterion::Stagnation).
+    Stagnated,
+    /// An iteration or time budget of the termination criterion is exhausted (see KrylovTerminationCriterion::Any).
+    BudgetExhausted,
+    /// The time budget of the iterative method is exhausted (see GenericIterativeMethod::setTimeBudget()).
+    DeadlineReached,
+    /// The solve has been cancelled via CancellationToken::cancel().
+    Cancelled
+  };
+
+  /**
+   * @brief Extends InverseOperatorResult with the reason for termination and the final error estimate.
+   *
+   * Filled if passed to GenericIterativeMethod::apply(). For InverseOperatorResult only InverseOperatorResult::converged is set.
+   */
+  struct IterativeMethodResult : InverseOperatorResult
+  {
+    void clear()
+    {
+      InverseOperatorResult::clear();
+      status = SolverStatus::MaxStepsReached;
+      errorEstimate = std::numeric_limits<double>::quiet_NaN();
+    }
+
+    SolverStatus status = SolverStatus::MaxStepsReached;
+    /// Error estimate of the termination criterion for the returned iterate.
+    double errorEstimate = std::numeric_limits<double>::quiet_NaN();
+  };
+
   //! @cond
   namespace Detail
   {
     /// Empty default storage object.
-    template <class domain_type, class range_type, class TerminationCriterion, class = void>
+    template <class domain_type, class range_type, class Step, class = void>
     struct Storage
     {
+      void setMode(RestartStorage) const noexcept
+      {}
+
       void store(const domain_type&, const range_type&) const noexcept
       {}
 
@@ -32,44 +91,113 @@ namespace Dune
     };
 
     /**
-     * @brief Storage object for GenericIterativeMethod with a termination criterion that may trigger restarts.
+     * @brief Storage object for GenericIterativeMethod with a step that may trigger restarts.
      *
-     * Stores initial guess \f$ x0 \f$ and initial right hand side \f$ b0 \f$.
+     * Stores initial guess \f$ x0 \f$ and initial right hand side \f$ b0 \f$. Buffers are reused in subsequent solves if the sizes match.
      */
-    template <class domain_type, class range_type, class TerminationCriterion>
-    struct Storage< domain_type, range_type, TerminationCriterion, void_t< Try::MemFn_restart<TerminationCriterion> > >
+    template <class domain_type, class range_type, class Step>
+    struct Storage< domain_type, range_type, Step, void_t< Try::MemFn_restart<Step> > >
     {
+      Storage() = default;
       Storage(Storage&&) = default;
       Storage& operator=(Storage&&) = default;
 
+      /// Stored vectors are only used within a single solve, thus only the mode is copied.
       Storage(const Storage& other)
-        : x0( other.x0 ? new domain_type(*other.x0) : nullptr ),
-          b0( other.b0 ? new range_type(*other.b0) : nullptr)
+        : mode( other.mode )
       {}
 
       Storage& operator=(const Storage& other)
       {
-        if( other.x0 )
-          x0.reset( new domain_type(*other.x0) );
-        if( other.b0 )
-          b0.reset( new range_type(*other.b0) );
+        mode = other.mode;
+        return *this;
+      }
+
+      void setMode(RestartStorage newMode)
+      {
+        mode = newMode;
+        if( mode == RestartStorage::None )
+        {
+          x0 = nullptr;
+          b0 = nullptr;
+        }
       }
 
       void store(const domain_type& x, const range_type& b)
       {
-        x0.reset( new domain_type(x) );
-        b0.reset( new range_type(b) );
+        if( mode == RestartStorage::None )
+          return;
+
+        if( mode == RestartStorage::ZeroInitialGuess )
+          assert( x.two_norm() == 0 );
+        else
+          assign( x0, x );
+        assign( b0, b );
       }
 
       void restore(domain_type& x, range_type& b) const
       {
-        assert(x0 && b0);
-        x = *x0;
+        if( mode == RestartStorage::None )
+          throw std::runtime_error("GenericIterativeMethod: Restart requested, but initial guess and right hand side were not stored (RestartStorage::None).");
+
+        if( mode == RestartStorage::ZeroInitialGuess )
+          x *= 0;
+        else
+        {
+          assert(x0);
+          x = *x0;
+        }
+        assert(b0);
         b = *b0;
       }
 
       std::unique_ptr<domain_type> x0;
       std::unique_ptr<range_type> b0;
+      RestartStorage mode = RestartStorage::InitialGuessAndRightHandSide;
+
+    private:
+      template <class Vector>
+      static void assign(std::unique_ptr<Vector>& stored, const Vector& v)
+      {
+        if( stored && stored->size() == v.size() )
+          *stored = v;
+        else
+          stored.reset( new Vector(v) );
+      }
+    };
+
+
+    /// Optional deadline on the monotonic clock, implemented with KrylovTerminationCriterion::WallClockBudget.
+    class Deadline
+    {
+      using Budget = KrylovTerminationCriterion::WallClockBudget<double>;
+
+    public:
+      void set(Budget::clock::duration budget, unsigned checkInterval)
+      {
+        budget_ = Budget(budget,checkInterval);
+        active_ = true;
+      }
+
+      void unset()
+      {
+        active_ = false;
+      }
+
+      void start()
+      {
+        if( active_ )
+          budget_.init();
+      }
+
+      bool reached()
+      {
+        return active_ && static_cast<bool>(budget_);
+      }
+
+    private:
+      Budget budget_ = Budget( Budget::clock::duration::zero() );
+      bool active_ = false;
     };
 
 
@@ -92,13 +220,15 @@ namespace Dune
       FGlue::IsBaseOf<Step>
     >;
 
-    /// Generate type that is derived from all necessary mixin base classes for GenericIterativeMethod.
+    /// Generate type that is derived from all necessary mixin base classes for GenericIterativeMethod (Mixin::MaxSteps is always a direct base class).
     template <class Step,
               class TerminationCriterion,
               class real_type = real_t<typename Step::domain_type> >
     using AddMixins =
     Apply< Compose,
-      EnableBaseClassesIf< AdditionalMixinsCondition<Step,TerminationCriterion> , DUNE_ISTL_MIXINS( real_type ) >,
+      EnableBaseClassesIf< AdditionalMixinsCondition<Step,TerminationCriterion> ,
+                           Mixin::AbsoluteAccuracy<real_type>, Mixin::MinimalAccuracy<real_type>, Mixin::RelativeAccuracy<real_type>,
+                           Mixin::Verbosity, Mixin::Eps<real_type>, Mixin::IterativeRefinements >,
       EnableVerbosity<Step>
     >;
   }
@@ -134,18 +264,69 @@ namespace Dune
       }
     };
 
-    template < class Step, class domain_type, class range_type >
-    typename StepTraits< Step >::Cache createCache( domain_type& x, range_type& y )
-    {
-      return typename StepTraits< Step >::Cache( x, y );
-    }
-
     template < class Step, class Cache >
     void setCache( Step& step, Cache* cache )
     {
       StepTraits< Step >::setCache( step, cache );
     }
   }
+
+  namespace Detail
+  {
+    /// Cache of the step, optionally kept for subsequent solves with the same iterate and right hand side objects.
+    template <class Step>
+    class CacheStorage
+    {
+      using Cache = typename Optional::StepTraits<Step>::Cache;
+
+    public:
+      CacheStorage() = default;
+      CacheStorage(CacheStorage&&) = default;
+      CacheStorage& operator=(CacheStorage&&) = default;
+
+      /// The cache refers to the vectors of the last solve, thus only the mode is copied.
+      CacheStorage(const CacheStorage& other)
+        : reuse( other.reuse )
+      {}
+
+      CacheStorage& operator=(const CacheStorage& other)
+      {
+        reuse = other.reuse;
+        cache.reset();
+        return *this;
+      }
+
+      template <class Domain, class Range>
+      Cache& get(Domain& x, Range& b)
+      {
+        if( !reuse || !cache || &x != x0 || &b != b0 || x.size() != xSize || b.size() != bSize )
+        {
+          // release the old cache first, such that at most one cache is allocated at a time
+          cache.reset();
+          cache.reset( new Cache( x, b ) );
+          x0 = &x;
+          b0 = &b;
+          xSize = x.size();
+          bSize = b.size();
+        }
+        return *cache;
+      }
+
+      void release()
+      {
+        if( !reuse )
+          cache.reset();
+      }
+
+      bool reuse = false;
+
+    private:
+      std::unique_ptr<Cache> cache;
+      const void* x0 = nullptr;
+      const void* b0 = nullptr;
+      std::size_t xSize = 0, bSize = 0;
+    };
+  }
   //! @endcond
 
 
@@ -218,36 +399,91 @@ namespace Dune
                                 maxSteps )
     {}
 
-//    GenericIterativeMethod(const GenericIterativeMethod& other)
-//      : Step(static_cast<const Step&>(other)),
-//        Mixin::MaxSteps(other),
-//        terminate_(other.terminate_)
-//    {
-//      initializeConnections();
-//    }
+    /*!
+      @brief Copy constructor, see clone().
+     */
+    GenericIterativeMethod(const GenericIterativeMethod& other)
+      : InverseOperator<domain_type,range_type>( other ),
+        Mixin::MaxSteps( other ),
+        Detail::AddMixins<Step_,TerminationCriterion_>( other ),
+        step_( other.step_ ),
+        terminate_( other.terminate_ ),
+        storage_( other.storage_ ),
+        cache_( other.cache_ ),
+        deadline_( other.deadline_ ),
+        cancellationToken_( other.cancellationToken_ )
+    {
+      initializeConnections();
+      Optional::setInitialEnergy( terminate_, real_type(0) );
+    }
 
     GenericIterativeMethod(GenericIterativeMethod&& other)
-      : Mixin::MaxSteps( other.maxSteps() ),
+      : InverseOperator<domain_type,range_type>( std::move( other ) ),
+        Mixin::MaxSteps( std::move( other ) ),
+        Detail::AddMixins<Step_,TerminationCriterion_>( std::move( other ) ),
         step_( std::move( other.step_ ) ),
-        terminate_( std::move( other.terminate_ ) )
+        terminate_( std::move( other.terminate_ ) ),
+        storage_( std::move( other.storage_ ) ),
+        cache_( std::move( other.cache_ ) ),
+        deadline_( other.deadline_ ),
+        cancellationToken_( other.cancellationToken_ ),
+        progress_( other.progress_ ),
+        computeInitialGuess_( std::move( other.computeInitialGuess_ ) ),
+        storeSolution_( std::move( other.storeSolution_ ) )
     {
       initializeConnections();
     }
 
-//    GenericIterativeMethod& operator=(const GenericIterativeMethod& other)
-//    {
-//      Step::operator=(static_cast<const Step&>(other));
-//      Mixin::MaxSteps::operator=(other);
-//      terminate_ = other.terminate_;
-//      initializeConnections();
-//    }
+    //! Copy assignment, requires that Step is copy assignable. As for clone(), the initial guess generator is not copied.
+    GenericIterativeMethod& operator=(const GenericIterativeMethod& other)
+    {
+      Mixin::MaxSteps::operator=( other );
+      Detail::AddMixins<Step_,TerminationCriterion_>::operator=( other );
+      step_ = other.step_;
+      terminate_ = other.terminate_;
+      storage_ = other.storage_;
+      cache_ = other.cache_;
+      deadline_ = other.deadline_;
+      cancellationToken_ = other.cancellationToken_;
+      progress_ = nullptr;
+      computeInitialGuess_ = nullptr;
+      storeSolution_ = nullptr;
+      initializeConnections();
+      Optional::setInitialEnergy( terminate_, real_type(0) );
+      return *this;
+    }
 
+    //! Move assignment, requires that Step is move assignable.
     GenericIterativeMethod& operator=(GenericIterativeMethod&& other)
     {
-      step_ = std::move(static_cast<Step&&>(other));
-      Mixin::MaxSteps::operator=(std::move(other));
-      terminate_ = std::move(other.terminate_);
+      Mixin::MaxSteps::operator=( std::move( other ) );
+      Detail::AddMixins<Step_,TerminationCriterion_>::operator=( std::move( other ) );
+      step_ = std::move( other.step_ );
+      terminate_ = std::move( other.terminate_ );
+      storage_ = std::move( other.storage_ );
+      cache_ = std::move( other.cache_ );
+      deadline_ = other.deadline_;
+      cancellationToken_ = other.cancellationToken_;
+      progress_ = other.progress_;
+      computeInitialGuess_ = std::move( other.computeInitialGuess_ );
+      storeSolution_ = std::move( other.storeSolution_ );
       initializeConnections();
+      return *this;
+    }
+
+    /*!
+      @brief Create an independent solver with the same configuration.
+
+      The clone shares operator, preconditioner and scalar product with this object, and copies the parameters of step and
+      termination criterion, the restart storage mode, the time budget and the cancellation token.
+      Only the workspace is separate: restart buffers and the cache are not copied but allocated in the first solve. Progress is not published by the clone (see setProgress()), since SolverProgress admits only one writer.
+      For the same reason the initial guess generator is not copied, i.e. the clone uses the initial iterates passed to apply().
+      Call setInitialGuess() with a separate generator for each clone that should compute initial iterates.
+      Clones may be used concurrently, provided that operator and preconditioner support this.
+     */
+    GenericIterativeMethod clone() const
+    {
+      return GenericIterativeMethod( *this );
     }
 
     /*!
@@ -257,23 +493,46 @@ namespace Dune
       @param res some statistics
      */
     virtual void apply(domain_type& x, range_type& b, InverseOperatorResult& res)
+    {
+      IterativeMethodResult result;
+      apply( x, b, result );
+      res = result;
+    }
+
+    /*!
+      @brief Apply iterative method to solve \f$Ax=b\f$.
+      @param x initial iterate
+      @param b initial right hand side
+      @param res some statistics, including the reason for termination
+     */
+    void apply(domain_type& x, range_type& b, IterativeMethodResult& res)
     {
       if( this->verbosityLevel() > 1)
         std::cout << "\n === " << step_.name() << " === " << std::endl;
 
-      auto cache = Optional::createCache< Step >( x, b );
-      Optional::setCache( step_, &cache );
+      if( computeInitialGuess_ )
+        Optional::setInitialEnergy( terminate_, computeInitialGuess_(x,b) );
+
+      // store initial guess and right hand side before the cache overwrites the right hand side with the initial residual
+      storage_.store(x,b);
+      Optional::setCache( step_, &cache_.get( x, b ) );
 
       initialize(x,b);
+      deadline_.start();
 
       auto step=1u;
+      auto deadlineReached = false, cancelled = false;
       real_type lastErrorEstimate = 1;
 
       for(; step<=maxSteps(); ++step)
       {
         step_.compute(x,b);
+        Optional::adjustEnergyEstimate( step_, terminate_ );
 
-        if( terminate_ )
+        auto converged = terminate_ || Optional::terminate( step_ );
+        if( progress_ )
+          progress_->publish( step, terminate_.errorEstimate(), Optional::regularizationParameter( step_ ) );
+        if( converged )
           break;
 
         if( Optional::restart( step_ ) )
@@ -283,20 +542,43 @@ namespace Dune
           terminate_.init();
           step = 0u;
           lastErrorEstimate = 1;
-          continue;
         }
-
-        if( this->verbosityLevel() > 1 )
+        else if( this->verbosityLevel() > 1 )
         {
           printOutput(step,lastErrorEstimate);
           lastErrorEstimate = terminate_.errorEstimate();
         }
+
+        // only checked after completed restarts, such that x is always a consistent iterate
+        if( cancellationToken_ && cancellationToken_->cancelled() )
+        {
+          cancelled = true;
+          break;
+        }
+        if( deadline_.reached() )
+        {
+          deadlineReached = true;
+          break;
+        }
       }
 
       step_.postProcess(x);
+      if( storeSolution_ )
+        storeSolution_(x);
       terminate_.print(res);
-      if( step < maxSteps() + 1 ) res.converged = true;
-      if( this->is_verbose() )  printFinalOutput(res,step);
+      res.status = ( step < maxSteps() + 1 ) ? SolverStatus::Converged : SolverStatus::MaxStepsReached;
+      if( Optional::stagnated( terminate_ ) )
+        res.status = SolverStatus::Stagnated;
+      else if( res.status == SolverStatus::Converged && Optional::budgetExhausted( terminate_ ) )
+        res.status = SolverStatus::BudgetExhausted;
+      if( deadlineReached )
+        res.status = SolverStatus::DeadlineReached;
+      if( cancelled )
+        res.status = SolverStatus::Cancelled;
+      res.errorEstimate = terminate_.errorEstimate();
+      res.converged = res.status == SolverStatus::Converged;
+      if( this->is_verbose() )  printFinalOutput(res);
+      cache_.release();
     }
 
     /*!
@@ -323,6 +605,115 @@ namespace Dune
       apply( x, b, res);
     }
 
+    /*!
+      @brief Compute initial iterates from previous solutions (see ProjectionInitialGuess).
+
+      In each call of apply() the given initial iterate is replaced by initialGuess.apply(x,b), which must return the squared energy
+      norm of the computed initial iterate. This is passed to the termination criterion, if it provides setInitialEnergy(). After each solve
+      the solution is passed to initialGuess.push_back(x).
+
+      The generator is modified in each solve and is thus not shared with copies of this object (see clone()).
+
+      @param initialGuess generator of initial iterates, must outlive this object
+     */
+    template <class InitialGuess>
+    void setInitialGuess(InitialGuess& initialGuess)
+    {
+      computeInitialGuess_ = [&initialGuess](domain_type& x, const range_type& b) { return real_type( initialGuess.apply(x,b) ); };
+      storeSolution_ = [&initialGuess](const domain_type& x) { initialGuess.push_back(x); };
+    }
+
+    //! Use the initial iterates passed to apply().
+    void resetInitialGuess()
+    {
+      computeInitialGuess_ = nullptr;
+      storeSolution_ = nullptr;
+      Optional::setInitialEnergy( terminate_, real_type(0) );
+    }
+
+    /*!
+      @brief Select the data that is stored for restarts (only relevant for steps that may restart, such as RCG and TRCG).
+      @param mode see RestartStorage
+     */
+    void setRestartStorage(RestartStorage mode)
+    {
+      storage_.setMode(mode);
+    }
+
+    /*!
+      @brief Keep the cache of the step (i.e. its auxiliary vectors) after apply() and reuse it in subsequent solves.
+
+      The cache refers to the iterate and the right hand side of the solve. Thus, it is only reused if apply() is called with the same
+      objects x and b as before and their sizes are unchanged, otherwise it is recreated. This avoids the allocations per solve if many
+      small systems are solved with the same workspace vectors (see ParallelBatchSolver).
+     */
+    void enableCacheReuse()
+    {
+      cache_.reuse = true;
+    }
+
+    //! Create the cache in each solve and release it afterwards (default).
+    void disableCacheReuse()
+    {
+      cache_.reuse = false;
+      cache_.release();
+    }
+
+    /*!
+      @brief Bound the wall-clock time of each call of apply().
+
+      The monotonic clock is read after every checkInterval-th iteration. If the deadline is reached, the current iterate is returned
+      with SolverStatus::DeadlineReached and the error estimate of the termination criterion in IterativeMethodResult. Restarts
+      are always completed before the deadline is checked, i.e. for RCG and TRCG the returned iterate is never half-restarted.
+
+      @param budget time budget per solve
+      @param checkInterval read the clock every checkInterval iterations
+     */
+    void setTimeBudget(std::chrono::steady_clock::duration budget, unsigned checkInterval = 1)
+    {
+      deadline_.set(budget,checkInterval);
+    }
+
+    //! Only terminate via the termination criterion and maxSteps() (default).
+    void removeTimeBudget()
+    {
+      deadline_.unset();
+    }
+
+    /*!
+      @brief Allow other threads to cancel apply().
+
+      The token is checked once per iteration, after restarts have been completed. A cancelled solve returns the current iterate with
+      SolverStatus::Cancelled.
+
+      @param token cancellation token, must outlive this object or be removed with removeCancellationToken()
+     */
+    void setCancellationToken(const CancellationToken& token)
+    {
+      cancellationToken_ = &token;
+    }
+
+    //! Remove cancellation token.
+    void removeCancellationToken()
+    {
+      cancellationToken_ = nullptr;
+    }
+
+    /*!
+      @brief Publish iteration, error estimate and regularization parameter after each iteration.
+      @param progress progress object that can be read from other threads, must outlive this object or be removed with removeProgress()
+     */
+    void setProgress(SolverProgress& progress)
+    {
+      progress_ = &progress;
+    }
+
+    //! Stop publishing progress.
+    void removeProgress()
+    {
+      progress_ = nullptr;
+    }
+
     //! Access termination criterion.
     TerminationCriterion& getTerminationCriterion()
     {
@@ -347,11 +738,13 @@ namespace Dune
       using namespace Mixin;
       Optional::Mixin::Attach< DUNE_ISTL_MIXINS( real_type ) >::apply( *this, step_ );
       Optional::Mixin::Attach< DUNE_ISTL_MIXINS( real_type ) >::apply( *this, terminate_ );
+
+      // the maximal number of steps is owned by this object, forward it to attached objects
+      setMaxSteps( maxSteps() );
     }
 
     void initialize(domain_type& x, range_type& b)
     {
-      storage_.store(x,b);
       step_.init(x,b);
       terminate_.init();
     }
@@ -365,10 +758,18 @@ namespace Dune
                                                                lastErrorEstimate );
     }
 
-    void printFinalOutput(const InverseOperatorResult& res, unsigned step) const
+    void printFinalOutput(const IterativeMethodResult& res) const
     {
       auto name = step_.name();
-      name += ( (step==maxSteps()+1) ? ": Failed" : ": Converged" );
+      switch( res.status )
+      {
+        case SolverStatus::Converged:       name += ": Converged"; break;
+        case SolverStatus::MaxStepsReached: name += ": Failed"; break;
+        case SolverStatus::Stagnated:       name += ": Stagnated"; break;
+        case SolverStatus::BudgetExhausted: name += ": Budget exhausted"; break;
+        case SolverStatus::DeadlineReached: name += ": Deadline reached"; break;
+        case SolverStatus::Cancelled:       name += ": Cancelled"; break;
+      }
       std::cout << "\n === " << name << " === " << std::endl;
       this->printHeader(std::cout);
       InverseOperator<domain_type,range_type>::printOutput(std::cout,
@@ -381,7 +782,13 @@ namespace Dune
 
     Step step_;
     TerminationCriterion terminate_;
-    Detail::Storage<domain_type,range_type,TerminationCriterion> storage_;
+    Detail::Storage<domain_type,range_type,Step> storage_;
+    Detail::CacheStorage<Step> cache_;
+    Detail::Deadline deadline_;
+    const CancellationToken* cancellationToken_ = nullptr;
+    SolverProgress* progress_ = nullptr;
+    std::function<real_type(domain_type&,const range_type&)> computeInitialGuess_ = nullptr;
+    std::function<void(const domain_type&)> storeSolution_ = nullptr;
   };
 
   /*!
@@ -103,20 +103,33 @@ namespace Dune
 //        static_assert( LinOp::category == SolverCategory::sequential , "Linear operator must be sequential!" );
     }
 
+    /// Copies parameters and substeps. Observers of the mixins are not copied, the substeps are connected to the copy.
     GenericStep( const GenericStep& other )
-      : A_( other.A_ ),
+      : Mixins( other ),
+        Interface( other ),
+        A_( other.A_ ),
         P_( other.P_ ),
         ssp_( ),
-        sp_( other.sp_ )
+        sp_( other.usesOwnScalarProduct() ? ssp_ : other.sp_ ),
+        applyPreconditioner_( other.applyPreconditioner_ ),
+        computeSearchDirection_( other.computeSearchDirection_ ),
+        computeScaling_( other.computeScaling_ ),
+        update_( other.update_ )
     {
       initializeConnections( );
     }
 
     GenericStep( GenericStep&& other )
-      : A_( other.A_ ),
+      : Mixins( std::move(other) ),
+        Interface( std::move(other) ),
+        A_( other.A_ ),
         P_( other.P_ ),
         ssp_(),
-        sp_( other.sp_ )
+        sp_( other.usesOwnScalarProduct() ? ssp_ : other.sp_ ),
+        applyPreconditioner_( std::move(other.applyPreconditioner_) ),
+        computeSearchDirection_( std::move(other.computeSearchDirection_) ),
+        computeScaling_( std::move(other.computeScaling_) ),
+        update_( std::move(other.update_) )
     {
       initializeConnections( );
     }
@@ -167,6 +180,14 @@ namespace Dune
     }
 
   private:
+    using Mixins = GenericStepDetail::AddMixins< ApplyPreconditioner, ComputeSearchDirection, ComputeScaling, Update, real_t<Domain> >;
+
+    /// Check if the default sequential scalar product of this object is used (constructor without scalar product).
+    bool usesOwnScalarProduct() const
+    {
+      return &sp_ == &ssp_;
+    }
+
     void initializeConnections()
     {
       using FGlue::Connector;
@@ -0,0 +1,145 @@
+#ifndef DUNE_LANCZOS_TRIDIAGONAL_MATRIX_HH
+#define DUNE_LANCZOS_TRIDIAGONAL_MATRIX_HH
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+namespace Dune
+{
+  /*!
+    @brief Symmetric tridiagonal matrix of the Lanczos process that is implicitly performed by the conjugate gradient method.
+
+    Given the scalings \f$\alpha_k=\frac{(r_k,Pr_k)}{(\delta x_k,A\delta x_k)}\f$ and the coefficients \f$\beta_k=\frac{(r_{k+1},Pr_{k+1})}{(r_k,Pr_k)}\f$
+    of the conjugate gradient method, the Lanczos matrix \f$T\f$ has the entries
+    \f[ T_{kk} = \frac{1}{\alpha_k} + \frac{\beta_{k-1}}{\alpha_{k-1}},\quad T_{k,k+1} = \frac{\sqrt{\beta_k}}{\alpha_k}. \f]
+    Its eigenvalues, the Ritz values, approximate the spectrum of the preconditioned operator \f$PA\f$ (see @cite Liesen2013). The extreme
+    Ritz values are computed with bisection, based on Sturm sequences.
+   */
+  template <class real_type>
+  class LanczosTridiagonalMatrix
+  {
+  public:
+    //! Remove all entries.
+    void clear()
+    {
+      diagonal_.clear();
+      offDiagonal_.clear();
+    }
+
+    /*!
+      @brief Add row and column of one step of the conjugate gradient method.
+      @param alpha scaling of the search direction in the current step
+      @param beta coefficient of the previous search direction in the current step (ignored in the first step)
+     */
+    void push_back(real_type alpha, real_type beta)
+    {
+      assert(alpha > 0);
+      if( diagonal_.empty() )
+      {
+        diagonal_.push_back( 1/alpha );
+      }
+      else
+      {
+        using std::sqrt;
+        diagonal_.push_back( 1/alpha + beta/lastAlpha_ );
+        offDiagonal_.push_back( sqrt(beta)/lastAlpha_ );
+      }
+      lastAlpha_ = alpha;
+    }
+
+    //! Dimension of the Lanczos matrix, i.e. number of performed steps.
+    std::size_t size() const
+    {
+      return diagonal_.size();
+    }
+
+    //! Diagonal entry \f$T_{kk}\f$.
+    real_type diagonal(std::size_t k) const
+    {
+      assert( k < size() );
+      return diagonal_[k];
+    }
+
+    //! Off-diagonal entry \f$T_{k,k+1}=T_{k+1,k}\f$.
+    real_type offDiagonal(std::size_t k) const
+    {
+      assert( k+1 < size() );
+      return offDiagonal_[k];
+    }
+
+    //! Smallest eigenvalue of the Lanczos matrix.
+    real_type smallestRitzValue() const
+    {
+      return eigenvalue(0);
+    }
+
+    //! Largest eigenvalue of the Lanczos matrix.
+    real_type largestRitzValue() const
+    {
+      return eigenvalue( size()-1 );
+    }
+
+    //! Estimate of the condition number of the preconditioned operator, i.e. ratio of largest and smallest Ritz value.
+    real_type conditionNumber() const
+    {
+      return largestRitzValue()/smallestRitzValue();
+    }
+
+  private:
+    /// Compute the i-th eigenvalue (in ascending order) by bisection.
+    real_type eigenvalue(std::size_t i) const
+    {
+      assert( i < size() );
+
+      // Gershgorin bounds
+      using std::abs;
+      using std::max;
+      using std::min;
+      auto lower = std::numeric_limits<real_type>::max(), upper = std::numeric_limits<real_type>::lowest();
+      for( std::size_t k = 0; k < size(); ++k )
+      {
+        auto radius = ( k > 0 ? abs(offDiagonal_[k-1]) : real_type(0) ) + ( k+1 < size() ? abs(offDiagonal_[k]) : real_type(0) );
+        lower = min( lower, diagonal_[k] - radius );
+        upper = max( upper, diagonal_[k] + radius );
+      }
+
+      const auto eps = std::numeric_limits<real_type>::epsilon();
+      while( upper - lower > 2 * eps * max( abs(lower), abs(upper) ) )
+      {
+        auto mid = ( lower + upper ) / 2;
+        if( mid == lower || mid == upper )
+          break;
+        if( numberOfEigenvaluesBelow(mid) > i )
+          upper = mid;
+        else
+          lower = mid;
+      }
+      return ( lower + upper ) / 2;
+    }
+
+    /// Number of eigenvalues smaller than x (Sturm sequence).
+    std::size_t numberOfEigenvaluesBelow(real_type x) const
+    {
+      using std::abs;
+      std::size_t count = 0;
+      real_type d = 1;
+      for( std::size_t k = 0; k < size(); ++k )
+      {
+        d = diagonal_[k] - x - ( k > 0 ? offDiagonal_[k-1]*offDiagonal_[k-1]/d : real_type(0) );
+        if( d == 0 )
+          d = -std::numeric_limits<real_type>::epsilon() * ( abs(diagonal_[k]) + abs(x) + std::numeric_limits<real_type>::min() );
+        if( d < 0 )
+          ++count;
+      }
+      return count;
+    }
+
+    std::vector<real_type> diagonal_ = {}, offDiagonal_ = {};
+    real_type lastAlpha_ = 1;
+  };
+}
+
+#endif // DUNE_LANCZOS_TRIDIAGONAL_MATRIX_HH
@@ -0,0 +1,412 @@
+#ifndef DUNE_MIXED_PRECISION_CG_SOLVER_HH
+#define DUNE_MIXED_PRECISION_CG_SOLVER_HH
+
+#include <cmath>
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+#include <dune/common/fvector.hh>
+#include <dune/common/typetraits.hh>
+#include <dune/istl/bvector.hh>
+
+#include "cg_solver.hh"
+#include "generic_iterative_method.hh"
+#include "generic_step.hh"
+#include "relative_energy_termination_criterion.hh"
+#include "residual_replacement.hh"
+
+namespace Dune
+{
+  namespace MixedPrecisionCGSpec
+  {
+    /**
+     * @brief Single precision counterpart of a vector type.
+     *
+     * Specializations provide the nested type 'type' and a static function 'create(const Vector&)' that returns a vector of
+     * matching size. Specialize for other vector types.
+     */
+    template <class Vector>
+    struct LowPrecision;
+
+    //! FieldVector<K,n> is stored as FieldVector<float,n>.
+    template <class K, int n>
+    struct LowPrecision< FieldVector<K,n> >
+    {
+      using type = FieldVector<float,n>;
+
+      static type create(const FieldVector<K,n>&)
+      {
+        return type(0);
+      }
+    };
+
+    //! BlockVector<B> is stored as BlockVector with single precision blocks.
+    template <class B, class A>
+    struct LowPrecision< BlockVector<B,A> >
+    {
+      using type = BlockVector< typename LowPrecision<B>::type >;
+
+      static type create(const BlockVector<B,A>& v)
+      {
+        auto result = type(v.size());
+        for( std::size_t i = 0; i < v.size(); ++i )
+          result[i] = LowPrecision<B>::create(v[i]);
+        return result;
+      }
+    };
+
+    //! @cond
+    namespace Detail
+    {
+      template <class T>
+      using IsScalar = std::is_arithmetic<T>;
+
+      /// y = x
+      template <class X, class Y, typename std::enable_if< IsScalar<Y>::value >::type* = nullptr>
+      void assign(const X& x, Y& y)
+      {
+        y = static_cast<Y>(x);
+      }
+
+      template <class X, class Y, typename std::enable_if< !IsScalar<Y>::value >::type* = nullptr>
+      void assign(const X& x, Y& y)
+      {
+        for( std::size_t i = 0; i < y.size(); ++i )
+          assign(x[i],y[i]);
+      }
+
+      /// y += a*x, computed in the precision of y
+      template <class real_type, class X, class Y, typename std::enable_if< IsScalar<Y>::value >::type* = nullptr>
+      void axpy(real_type a, const X& x, Y& y)
+      {
+        y += a*x;
+      }
+
+      template <class real_type, class X, class Y, typename std::enable_if< !IsScalar<Y>::value >::type* = nullptr>
+      void axpy(real_type a, const X& x, Y& y)
+      {
+        for( std::size_t i = 0; i < y.size(); ++i )
+          axpy(a,x[i],y[i]);
+      }
+
+      /// result += (x,y), accumulated in the precision of result
+      template <class real_type, class X, class Y, typename std::enable_if< IsScalar<Y>::value >::type* = nullptr>
+      void addDot(const X& x, const Y& y, real_type& result)
+      {
+        result += static_cast<real_type>(x)*static_cast<real_type>(y);
+      }
+
+      template <class real_type, class X, class Y, typename std::enable_if< !IsScalar<Y>::value >::type* = nullptr>
+      void addDot(const X& x, const Y& y, real_type& result)
+      {
+        for( std::size_t i = 0; i < y.size(); ++i )
+          addDot(x[i],y[i],result);
+      }
+
+      template <class real_type, class X, class Y>
+      real_type dot(const X& x, const Y& y)
+      {
+        auto result = real_type(0);
+        addDot(x,y,result);
+        return result;
+      }
+    }
+    //! @endcond
+
+
+    /**
+     * @brief Cache object for the mixed precision conjugate gradient method.
+     *
+     * Iterate and residual are stored in the precision of Domain and Range, preconditioned residual,
+     * search direction and its image in single precision, together with a single precision copy of the residual that
+     * serves as input of the preconditioner.
+     */
+    template <class Domain, class Range>
+    struct Cache
+    {
+      using real_type = real_t<Domain>;
+      using LowDomain = typename LowPrecision<Domain>::type;
+      using LowRange = typename LowPrecision<Range>::type;
+
+      Cache( Domain& x0, Range& b0 )
+        : x(x0), r(b0),
+          lowR( LowPrecision<Range>::create(b0) ),
+          Pr( LowPrecision<Domain>::create(x0) ), dx(Pr),
+          Adx(lowR)
+      {}
+
+      void reset(LinearOperator<Domain,Range>* A_,
+                Preconditioner<Domain,Range>* P_,
+                ScalarProduct<Domain>* sp_)
+      {
+        if( !lowA || !lowP )
+          throw std::runtime_error("MixedPrecisionCGSolver: Single precision operator and preconditioner are not set (see setLowPrecisionOperators).");
+
+        A = A_;
+        P = P_;
+        sp = sp_;
+        A->applyscaleadd(-1,x,r);
+        residualNorm = sp->norm ( r );
+        alpha = beta = sigma = dxAdx = -1;
+        firstStep = true;
+        if( lanczosRecorder )
+          lanczosRecorder->clear();
+      }
+
+      Domain& x;
+      Range& r;
+      real_type alpha = -1, beta = -1, sigma = -1, dxAdx = -1, residualNorm = 1;
+      LowRange lowR;
+      LowDomain Pr, dx;
+      LowRange Adx;
+      bool firstStep = true;
+
+      LinearOperator<Domain,Range>* A = nullptr;
+      Preconditioner<Domain,Range>* P = nullptr;
+      ScalarProduct<Domain>* sp = nullptr;
+      LinearOperator<LowDomain,LowRange>* lowA = nullptr;
+      Preconditioner<LowDomain,LowRange>* lowP = nullptr;
+      LanczosTridiagonalMatrix<real_type>* lanczosRecorder = nullptr;
+    };
+
+
+    //! @cond
+    class Name
+    {
+    public:
+      std::string name() const
+      {
+        return "Mixed Precision Conjugate Gradients";
+      }
+    };
+    //! @endcond
+
+
+    //! Extends public interface of GenericStep for the mixed precision conjugate gradient method.
+    template <class Cache, class Name>
+    class InterfaceImpl : public CGSpec::InterfaceImpl<Cache,Name>
+    {
+      using LowDomain = typename Cache::LowDomain;
+      using LowRange = typename Cache::LowRange;
+
+    public:
+      void setCache(Cache* cache)
+      {
+        CGSpec::InterfaceImpl<Cache,Name>::setCache(cache);
+        cache_->lowA = lowA_;
+        cache_->lowP = lowP_;
+      }
+
+      /**
+       * @brief Set single precision versions of operator and preconditioner. Both must outlive the solver.
+       *
+       * Required before the first solve. The operator and preconditioner passed to the constructor are used for the residual
+       * replacement, resp. for pre() and post(), only.
+       */
+      void setLowPrecisionOperators(LinearOperator<LowDomain,LowRange>& A, Preconditioner<LowDomain,LowRange>& P)
+      {
+        lowA_ = &A;
+        lowP_ = &P;
+      }
+
+    protected:
+      using CGSpec::InterfaceImpl<Cache,Name>::cache_;
+
+    private:
+      LinearOperator<LowDomain,LowRange>* lowA_ = nullptr;
+      Preconditioner<LowDomain,LowRange>* lowP_ = nullptr;
+    };
+
+
+    //! Cache with the data for the residual replacement (see ResidualReplacementSpec::Cache).
+    template <class Domain, class Range>
+    using ResidualReplacementCache = ResidualReplacementSpec::Cache< Domain, Range, Cache<Domain,Range> >;
+
+    //! Bind template arguments of MixedPrecisionCGSpec::InterfaceImpl and add the interface of the residual replacement.
+    template <class Domain, class Range>
+    using Interface = ResidualReplacementSpec::InterfaceImpl< ResidualReplacementCache<Domain,Range>, Name,
+                                                              InterfaceImpl< ResidualReplacementCache<Domain,Range>, Name > >;
+
+
+    //! Apply single precision preconditioner to the rounded residual, \f$(r,Pr)\f$ is accumulated in double precision.
+    class ApplyPreconditioner
+    {
+    public:
+      template < class Cache >
+      void operator()( Cache& cache ) const
+      {
+        Detail::assign( cache.r, cache.lowR );
+        cache.lowP->apply( cache.Pr, cache.lowR );
+
+        using std::abs;
+        if( cache.sigma < 0 )
+          cache.sigma = abs( Detail::dot<typename Cache::real_type>( cache.r, cache.Pr ) );
+        cache.residualNorm = cache.sp->norm( cache.r );
+      }
+
+      template <class Preconditioner, class Domain, class Range>
+      void pre(Preconditioner& P, Domain& x, Range& b) const
+      {
+        P.pre(x,b);
+      }
+
+      template <class Preconditioner, class Domain>
+      void post(Preconditioner& P, Domain& x) const
+      {
+        P.post(x);
+      }
+    };
+
+
+    //! Compute single precision search direction and apply the single precision operator.
+    class SearchDirection
+    {
+    public:
+      template < class Cache >
+      void operator()( Cache& cache ) const
+      {
+        using real_type = typename Cache::real_type;
+        if( cache.firstStep )
+        {
+          cache.dx = cache.Pr;
+          cache.firstStep = false;
+        }
+        else
+        {
+          using std::abs;
+          auto newSigma = abs( Detail::dot<real_type>( cache.r, cache.Pr ) );
+          cache.beta = newSigma/cache.sigma;
+          cache.dx *= static_cast< field_t<typename Cache::LowDomain> >( cache.beta ); cache.dx += cache.Pr;
+          cache.sigma = newSigma;
+        }
+
+        cache.lowA->apply( cache.dx, cache.Adx );
+        cache.dxAdx = Detail::dot<real_type>( cache.dx, cache.Adx );
+      }
+    };
+
+
+    //! Update iterate and residual in double precision.
+    class UpdateIterate
+    {
+    public:
+      template < class Cache >
+      void operator()( Cache& cache ) const
+      {
+        if( cache.lanczosRecorder && cache.alpha > 0 )
+          cache.lanczosRecorder->push_back( cache.alpha, cache.beta );
+
+        Detail::axpy( cache.alpha, cache.dx, cache.x );
+        Detail::axpy( -cache.alpha, cache.Adx, cache.r );
+      }
+    };
+
+
+    /**
+     * @brief Step implementation for the mixed precision conjugate gradient method.
+     *
+     * The residual is replaced by \f$b-Ax\f$, computed in double precision, if the estimated gap between updated and true residual becomes
+     * too large (see ResidualReplacementSpec::UpdateIterate). The gap is estimated with the unit roundoff of single precision.
+     */
+    template <class Domain, class Range=Domain>
+    using Step =
+    GenericStep< Domain, Range,
+      ApplyPreconditioner,
+      SearchDirection,
+      CGSpec::Scaling,
+      ResidualReplacementSpec::UpdateIterate< UpdateIterate, field_t< typename LowPrecision<Domain>::type > >,
+      Interface< Domain, Range >
+    >;
+  }
+
+
+  namespace ResidualReplacementSpec
+  {
+    //! Norms of the single precision search direction and its image, accumulated in double precision.
+    template <class Domain, class Range>
+    struct SearchDirectionNorms< MixedPrecisionCGSpec::Cache<Domain,Range> >
+    {
+      using BaseCache = MixedPrecisionCGSpec::Cache<Domain,Range>;
+      using real_type = typename BaseCache::real_type;
+
+      static real_type dx(const BaseCache& cache)
+      {
+        using std::sqrt;
+        return sqrt( MixedPrecisionCGSpec::Detail::dot<real_type>( cache.dx, cache.dx ) );
+      }
+
+      static real_type Adx(const BaseCache& cache)
+      {
+        using std::sqrt;
+        return sqrt( MixedPrecisionCGSpec::Detail::dot<real_type>( cache.Adx, cache.Adx ) );
+      }
+    };
+  }
+
+
+  /*!
+    @ingroup ISTL_Solvers
+    @brief Mixed precision conjugate gradient method.
+
+    Preconditioned residual, search direction and its image are stored in single precision and preconditioner and operator are applied
+    in single precision, which approximately halves the memory traffic of bandwidth-bound solves. Iterate and residual are updated in
+    double precision and all scalar products are accumulated in double precision. The updated residual is replaced by the true residual
+    if the estimated gap between both becomes too large (see ResidualReplacementSpec::UpdateIterate), so that the attainable accuracy is
+    not limited by single precision.
+
+    Single precision vector types are obtained from MixedPrecisionCGSpec::LowPrecision. Mixed precision scalar products are computed
+    without the scalar product, i.e. the method is restricted to sequential computations with real field types.
+
+    @code{.cpp}
+    auto cg = make_cg<MixedPrecisionCGSolver,KrylovTerminationCriterion::ResidualBased>(A,P,sp,lowA,lowP);
+    @endcode
+
+    @tparam Domain domain space \f$X\f$
+    @tparam Range range space \f$Y\f$
+    @tparam TerminationCriterion termination criterion (such as Dune::KrylovTerminationCriterion::ResidualBased or Dune::KrylovTerminationCriterion::RelativeEnergyError (default))
+   */
+  template <class Domain, class Range,
+            template <class> class TerminationCriterion = KrylovTerminationCriterion::RelativeEnergyError>
+  using MixedPrecisionCGSolver = GenericIterativeMethod< MixedPrecisionCGSpec::Step<Domain,Range> , TerminationCriterion< real_t<Domain> > >;
+
+
+  /*!
+    @ingroup ISTL_Solvers
+    @brief Generate mixed precision conjugate gradient method.
+
+    Same as make_cg(A,P,sp,...), additionally sets the single precision operator and preconditioner.
+
+    @param A linear operator, used for the residual replacement
+    @param P preconditioner, used for pre() and post()
+    @param sp scalar product
+    @param lowA single precision linear operator
+    @param lowP single precision preconditioner
+    @param accuracy relative accuracy
+    @param nSteps maximal number of steps
+    @param verbosityLevel =1: print final statistics, =2: print information in each iteration
+    @param eps maximal attainable accuracy
+    @tparam CGType conjugate gradient variant (=MixedPrecisionCGSolver)
+    @tparam TerminationCriterion termination criterion (such as Dune::KrylovTerminationCriterion::ResidualBased or Dune::KrylovTerminationCriterion::RelativeEnergyError)
+   */
+  template <template <class,class,template <class> class> class CGType,
+            template <class> class TerminationCriterion,
+            class Domain, class Range, class LowDomain, class LowRange, class real_type = real_t<Domain> >
+  CGType<Domain,Range,TerminationCriterion> make_cg(LinearOperator<Domain,Range>& A,
+                                                    Preconditioner<Domain,Range>& P,
+                                                    ScalarProduct<Domain>& sp,
+                                                    LinearOperator<LowDomain,LowRange>& lowA,
+                                                    Preconditioner<LowDomain,LowRange>& lowP,
+                                                    real_type accuracy = 1e-15, unsigned nSteps = 1000,
+                                                    unsigned verbosityLevel = 0, real_type eps = 1e-15)
+  {
+    auto cg = make_cg<CGType,TerminationCriterion>(A,P,sp,accuracy,nSteps,verbosityLevel,eps);
+    cg.getStep().setLowPrecisionOperators(lowA,lowP);
+    return cg;
+  }
+}
+
+#endif // DUNE_MIXED_PRECISION_CG_SOLVER_HH
@@ -12,6 +12,18 @@ namespace Dune
     class MixinConnection
     {
     public:
+      MixinConnection() = default;
+
+      /// Observers are not copied, since they are connected to the original object.
+      MixinConnection(const MixinConnection&)
+      {}
+
+      /// Keeps the present observers, since they are connected to this object.
+      MixinConnection& operator=(const MixinConnection&)
+      {
+        return *this;
+      }
+
       /// Attach observer.
       void attach(Impl& observer)
       {
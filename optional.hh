@@ -20,6 +20,27 @@ namespace Dune
 
     template <class Type>
     using MemFn_restart = decltype(std::declval<Type>().restart());
+
+    template <class Type, class real_type>
+    using MemFn_setInitialEnergy = decltype(std::declval<Type>().setInitialEnergy(std::declval<real_type>()));
+
+    template <class Type>
+    using MemFn_stagnated = decltype(std::declval<Type>().stagnated());
+
+    template <class Type>
+    using MemFn_regularizationParameter = decltype(std::declval<Type>().regularizationParameter());
+
+    template <class Type>
+    using MemFn_budgetExhausted = decltype(std::declval<Type>().budgetExhausted());
+
+    template <class Type>
+    using MemFn_regularizedInPlace = decltype(std::declval<Type>().regularizedInPlace());
+
+    template <class Type>
+    using MemFn_energyIncrement = decltype(std::declval<Type>().energyIncrement());
+
+    template <class Type, class real_type>
+    using MemFn_restartEnergyEstimate = decltype(std::declval<Type>().restartEnergyEstimate(std::declval<real_type>()));
   }
   //! @endcond
 
@@ -86,6 +107,100 @@ namespace Dune
       };
 
 
+      template <class Type, class real_type, class = void>
+      struct SetInitialEnergy
+      {
+        static void apply(Type&, real_type)
+        {}
+      };
+
+      template <class Type, class real_type>
+      struct SetInitialEnergy< Type , real_type , void_t< Try::MemFn_setInitialEnergy<Type,real_type> > >
+      {
+        static void apply(Type& t, real_type energy)
+        {
+          t.setInitialEnergy(energy);
+        }
+      };
+
+
+      template <class Step, class TerminationCriterion, class = void>
+      struct AdjustEnergyEstimate
+      {
+        static void apply(const Step&, TerminationCriterion&)
+        {}
+      };
+
+      template <class Step, class TerminationCriterion>
+      struct AdjustEnergyEstimate< Step , TerminationCriterion ,
+                                   void_t< Try::MemFn_regularizedInPlace<Step>,
+                                           Try::MemFn_restartEnergyEstimate< TerminationCriterion, Try::MemFn_energyIncrement<Step> > > >
+      {
+        static void apply(const Step& step, TerminationCriterion& terminate)
+        {
+          if( step.regularizedInPlace() )
+            terminate.restartEnergyEstimate( step.energyIncrement() );
+        }
+      };
+
+
+      template <class Type, class = void>
+      struct Stagnated
+      {
+        static bool apply(const Type&)
+        {
+          return false;
+        }
+      };
+
+      template <class Type>
+      struct Stagnated< Type , void_t< Try::MemFn_stagnated<Type> > >
+      {
+        static bool apply(const Type& t)
+        {
+          return t.stagnated();
+        }
+      };
+
+
+      template <class Type, class = void>
+      struct BudgetExhausted
+      {
+        static bool apply(const Type&)
+        {
+          return false;
+        }
+      };
+
+      template <class Type>
+      struct BudgetExhausted< Type , void_t< Try::MemFn_budgetExhausted<Type> > >
+      {
+        static bool apply(const Type& t)
+        {
+          return t.budgetExhausted();
+        }
+      };
+
+
+      template <class Type, class = void>
+      struct RegularizationParameter
+      {
+        static double apply(const Type&)
+        {
+          return 0;
+        }
+      };
+
+      template <class Type>
+      struct RegularizationParameter< Type , void_t< Try::MemFn_regularizationParameter<Type> > >
+      {
+        static double apply(const Type& t)
+        {
+          return t.regularizationParameter();
+        }
+      };
+
+
       template <class Type, class = void>
       struct Terminate
       {
@@ -114,6 +229,27 @@ namespace Dune
     }
 
 
+    template <class Type>
+    bool stagnated(const Type& t)
+    {
+      return Detail::Stagnated<Type>::apply(t);
+    }
+
+
+    template <class Type>
+    bool budgetExhausted(const Type& t)
+    {
+      return Detail::BudgetExhausted<Type>::apply(t);
+    }
+
+
+    template <class Type>
+    double regularizationParameter(const Type& t)
+    {
+      return Detail::RegularizationParameter<Type>::apply(t);
+    }
+
+
     template <class Type>
     bool restart(const Type& t)
     {
@@ -121,6 +257,20 @@ namespace Dune
     }
 
 
+    template <class Type, class real_type>
+    void setInitialEnergy(Type& t, real_type energy)
+    {
+      Detail::SetInitialEnergy<Type,real_type>::apply(t,energy);
+    }
+
+
+    template <class Step, class TerminationCriterion>
+    void adjustEnergyEstimate(const Step& step, TerminationCriterion& terminate)
+    {
+      Detail::AdjustEnergyEstimate<Step,TerminationCriterion>::apply(step,terminate);
+    }
+
+
     template <class ToConnect, class Connector>
     void connect(const ToConnect& toConnect, Connector& connector)
     {
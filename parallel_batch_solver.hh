@@ -0,0 +1,296 @@
+#ifndef DUNE_PARALLEL_BATCH_SOLVER_HH
+#define DUNE_PARALLEL_BATCH_SOLVER_HH
+
+#include <algorithm>
+#include <cassert>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "dune/istl/solver.hh"
+
+namespace Dune
+{
+  //! @cond
+  namespace Detail
+  {
+    /// Range of task indices of one worker. The owner takes tasks from the front, other workers steal from the back.
+    class WorkQueue
+    {
+    public:
+      void assign(std::size_t begin, std::size_t end)
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        begin_ = begin;
+        end_ = end;
+      }
+
+      bool pop(std::size_t& task)
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if( begin_ == end_ )
+          return false;
+        task = begin_++;
+        return true;
+      }
+
+      bool steal(std::size_t& task)
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if( begin_ == end_ )
+          return false;
+        task = --end_;
+        return true;
+      }
+
+    private:
+      std::mutex mutex_;
+      std::size_t begin_ = 0, end_ = 0;
+    };
+  }
+  //! @endcond
+
+
+  /*!
+    @ingroup ISTL_Solvers
+    @brief Solves many independent systems \f$Ax_i=b_i\f$ with the same operator and preconditioner concurrently.
+
+    The worker threads are started once in the constructor and wait for subsequent batches, the calling thread acts as first worker.
+    Each worker owns one solver, which is cloned, resp. created with a factory, once in the constructor and reused for all
+    subsequent batches. The systems are distributed evenly to the workers, which steal remaining systems from each other when
+    they run out of work.
+
+    Each worker swaps the systems into its own workspace vectors and solves with cache reuse (see
+    GenericIterativeMethod::enableCacheReuse()). Thus, as long as the sizes of the systems do not change, the auxiliary vectors of
+    the steps (three for MyCGSolver) are allocated only once per worker.
+
+    Operator, preconditioner and scalar product are shared by all solvers and must support concurrent calls of apply()
+    (and of pre() and post() for the preconditioner). apply() must not be called concurrently on the same object.
+
+    @code{.cpp}
+    auto cg = MyCGSolver<Domain,Range>(A,P,sp);
+    ParallelBatchSolver< MyCGSolver<Domain,Range> > batchSolver(cg);
+    batchSolver.apply(x,b,res);
+    @endcode
+
+    @tparam Solver iterative method, i.e. GenericIterativeMethod, must be move constructible
+   */
+  template <class Solver>
+  class ParallelBatchSolver
+  {
+  public:
+    using domain_type = typename Solver::domain_type;
+    using range_type = typename Solver::range_type;
+
+    /*!
+      @param makeSolver creates solvers that share operator and preconditioner, called once per thread
+      @param numberOfThreads number of threads (default: std::thread::hardware_concurrency())
+     */
+    template <class SolverFactory,
+              typename std::enable_if< !std::is_base_of<Solver,SolverFactory>::value >::type* = nullptr>
+    explicit ParallelBatchSolver(SolverFactory makeSolver, unsigned numberOfThreads = 0)
+      : queues_( numberOfThreads > 0 ? numberOfThreads : std::max( 1u, std::thread::hardware_concurrency() ) ),
+        x_( queues_.size() ),
+        b_( queues_.size() ),
+        errors_( queues_.size() )
+    {
+      solvers_.reserve( queues_.size() );
+      for( std::size_t i = 0; i < queues_.size(); ++i )
+      {
+        solvers_.emplace_back( makeSolver() );
+        solvers_.back().enableCacheReuse();
+      }
+
+      threads_.reserve( queues_.size() - 1 );
+      try
+      {
+        for( std::size_t i = 1; i < queues_.size(); ++i )
+          threads_.emplace_back( [this,i] { wait(i); } );
+      }
+      catch(...)
+      {
+        // the destructor is not called, join the started threads
+        stop();
+        throw;
+      }
+    }
+
+    /*!
+      @param solver prototype, each thread uses a clone (see GenericIterativeMethod::clone()), i.e. an initial guess generator of the
+                    prototype is not used by the threads
+      @param numberOfThreads number of threads (default: std::thread::hardware_concurrency())
+     */
+    explicit ParallelBatchSolver(const Solver& solver, unsigned numberOfThreads = 0)
+      : ParallelBatchSolver( [&solver] { return solver.clone(); }, numberOfThreads )
+    {}
+
+    ParallelBatchSolver(const ParallelBatchSolver&) = delete;
+    ParallelBatchSolver& operator=(const ParallelBatchSolver&) = delete;
+
+    //! Stops and joins the worker threads.
+    ~ParallelBatchSolver()
+    {
+      stop();
+    }
+
+    /*!
+      @brief Solve \f$Ax_i=b_i\f$ for all i.
+      @param x initial iterates, overwritten with the solutions
+      @param b right hand sides, may be overwritten
+      @param res statistics of each solve, resized to x.size()
+
+      Exceptions thrown by the solvers are rethrown after all workers have finished the batch.
+     */
+    void apply(std::vector<domain_type>& x, std::vector<range_type>& b, std::vector<InverseOperatorResult>& res)
+    {
+      if( x.size() != b.size() )
+        throw std::invalid_argument("ParallelBatchSolver: Number of initial iterates and right hand sides differ.");
+      res.resize( x.size() );
+
+      auto n = queues_.size();
+      for( std::size_t i = 0; i < n; ++i )
+        queues_[i].assign( i*x.size()/n, (i+1)*x.size()/n );
+      errors_.assign( n, nullptr );
+
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        batch_ = Batch{ &x, &b, &res };
+        ++generation_;
+        running_ = n - 1;
+      }
+      start_.notify_all();
+
+      work(0);
+
+      {
+        std::unique_lock<std::mutex> lock(mutex_);
+        finished_.wait( lock, [this] { return running_ == 0; } );
+      }
+
+      for( auto& error : errors_ )
+        if( error )
+          std::rethrow_exception(error);
+    }
+
+    //! @return number of threads
+    std::size_t numberOfThreads() const
+    {
+      return solvers_.size();
+    }
+
+    //! Access solver of the i-th thread, i.e. to adjust its parameters between batches.
+    Solver& getSolver(std::size_t i)
+    {
+      assert( i < solvers_.size() );
+      return solvers_[i];
+    }
+
+  private:
+    struct Batch
+    {
+      std::vector<domain_type>* x;
+      std::vector<range_type>* b;
+      std::vector<InverseOperatorResult>* res;
+    };
+
+    /// Loop of the worker threads, processes one batch per generation.
+    void wait(std::size_t worker)
+    {
+      auto generation = 0ul;
+      while( true )
+      {
+        {
+          std::unique_lock<std::mutex> lock(mutex_);
+          start_.wait( lock, [this,generation] { return stop_ || generation_ != generation; } );
+          if( stop_ )
+            return;
+          generation = generation_;
+        }
+
+        work(worker);
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        if( --running_ == 0 )
+          finished_.notify_one();
+      }
+    }
+
+    void work(std::size_t worker)
+    {
+      try
+      {
+        std::size_t task;
+        while( queues_[worker].pop(task) )
+          solve(worker,task);
+
+        for( std::size_t i = 1; i < queues_.size(); ++i )
+        {
+          auto& victim = queues_[ (worker+i) % queues_.size() ];
+          while( victim.steal(task) )
+            solve(worker,task);
+        }
+      }
+      catch(...)
+      {
+        errors_[worker] = std::current_exception();
+      }
+    }
+
+    /// Solve in the workspace vectors of the worker, such that its solver reuses the cache.
+    void solve(std::size_t worker, std::size_t task)
+    {
+      using std::swap;
+      auto& x = (*batch_.x)[task];
+      auto& b = (*batch_.b)[task];
+      swap( x_[worker], x );
+      swap( b_[worker], b );
+      try
+      {
+        solvers_[worker].apply( x_[worker], b_[worker], (*batch_.res)[task] );
+      }
+      catch(...)
+      {
+        swap( x_[worker], x );
+        swap( b_[worker], b );
+        throw;
+      }
+      swap( x_[worker], x );
+      swap( b_[worker], b );
+    }
+
+    void stop()
+    {
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+      }
+      start_.notify_all();
+      for( auto& thread : threads_ )
+        thread.join();
+    }
+
+    std::vector<Detail::WorkQueue> queues_;
+    std::vector<Solver> solvers_;
+    /// workspace vectors of the workers
+    std::vector<domain_type> x_;
+    std::vector<range_type> b_;
+    std::vector<std::exception_ptr> errors_;
+
+    std::vector<std::thread> threads_;
+    std::mutex mutex_;
+    std::condition_variable start_, finished_;
+    Batch batch_ = {};
+    unsigned long generation_ = 0;
+    std::size_t running_ = 0;
+    bool stop_ = false;
+  };
+}
+
+#endif // DUNE_PARALLEL_BATCH_SOLVER_HH
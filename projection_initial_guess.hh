@@ -0,0 +1,151 @@
+#ifndef DUNE_PROJECTION_INITIAL_GUESS_HH
+#define DUNE_PROJECTION_INITIAL_GUESS_HH
+
+#include <cmath>
+#include <cstddef>
+#include <deque>
+#include <limits>
+
+#include <dune/common/typetraits.hh>
+#include <dune/istl/operators.hh>
+#include <dune/istl/scalarproducts.hh>
+
+namespace Dune
+{
+  /**
+   * @brief Initial guesses for sequences of linear systems with the same operator and correlated right hand sides.
+   *
+   * Keeps a bounded window of previous solutions, stored as \f$A\f$-orthonormal basis \f$w_1,\ldots,w_m\f$ of their span together with
+   * the images \f$Aw_i\f$. The initial guess is the Galerkin projection of the solution of \f$Ax=b\f$ onto this span, i.e. the
+   * \f$A\f$-optimal starting point \f$x_0=\sum_i (w_i,b)w_i\f$. It requires \f$m\f$ inner products and vector updates. Adding a solution
+   * requires one application of the linear operator.
+   *
+   * Since \f$x_0\f$ is a Galerkin projection, \f$\|x\|_A^2=\|x_0\|_A^2+\|x-x_0\|_A^2\f$. Thus the energy norm of the solution can still be
+   * estimated from below, which keeps KrylovTerminationCriterion::RelativeEnergyError valid (see
+   * KrylovTerminationCriterion::RelativeEnergyError::setInitialEnergy()).
+   *
+   * Usage with GenericIterativeMethod:
+   * @code{.cpp}
+   * auto initialGuess = ProjectionInitialGuess<Domain,Range>(A,sp);
+   * cg.setInitialGuess(initialGuess);
+   * @endcode
+   */
+  template <class Domain, class Range>
+  class ProjectionInitialGuess
+  {
+  public:
+    using real_type = real_t<Domain>;
+
+    /**
+     * @param A linear operator
+     * @param sp scalar product
+     * @param windowSize maximal number of stored directions
+     */
+    ProjectionInitialGuess(LinearOperator<Domain,Range>& A, ScalarProduct<Domain>& sp, unsigned windowSize = 8)
+      : A_(A), ssp_(), sp_(sp), windowSize_(windowSize)
+    {}
+
+    /**
+     * @param A linear operator
+     * @param windowSize maximal number of stored directions
+     */
+    explicit ProjectionInitialGuess(LinearOperator<Domain,Range>& A, unsigned windowSize = 8)
+      : A_(A), ssp_(), sp_(ssp_), windowSize_(windowSize)
+    {}
+
+    ProjectionInitialGuess(const ProjectionInitialGuess&) = delete;
+    ProjectionInitialGuess& operator=(const ProjectionInitialGuess&) = delete;
+
+    /**
+     * @brief Compute initial guess.
+     * @param x on exit contains the Galerkin projection of the solution onto the stored directions (the given value is ignored)
+     * @param b right hand side
+     * @return squared energy norm of the initial guess, i.e. \f$(x_0,Ax_0)\f$
+     */
+    real_type apply(Domain& x, const Range& b) const
+    {
+      x *= 0;
+      real_type energy = 0;
+      for( std::size_t i = 0; i < W_.size(); ++i )
+      {
+        auto coefficient = sp_.dot( W_[i], b );
+        x.axpy( coefficient, W_[i] );
+        energy += coefficient * coefficient;
+      }
+      return energy;
+    }
+
+    /**
+     * @brief Add solution.
+     *
+     * The solution is orthogonalized with respect to the energy inner product. It is discarded if it (nearly) lies in the span of the stored
+     * directions. If the window is full, the oldest direction is removed.
+     *
+     * @param x solution of a previous solve
+     */
+    void push_back(const Domain& x)
+    {
+      using std::sqrt;
+
+      auto w = x;
+      auto Aw = Range( x );
+      A_.apply( w, Aw );
+      auto energy = sp_.dot( w, Aw );
+      if( !( energy > 0 ) || windowSize_ == 0 )
+        return;
+
+      // classical Gram-Schmidt with reorthogonalization
+      for( auto pass = 0u; pass < 2u; ++pass )
+        for( std::size_t i = 0; i < W_.size(); ++i )
+        {
+          auto coefficient = sp_.dot( AW_[i], w );
+          w.axpy( -coefficient, W_[i] );
+          Aw.axpy( -coefficient, AW_[i] );
+        }
+
+      auto remainingEnergy = sp_.dot( w, Aw );
+      if( !( remainingEnergy > 100 * std::numeric_limits<real_type>::epsilon() * energy ) )
+        return;
+
+      w *= 1/sqrt( remainingEnergy );
+      Aw *= 1/sqrt( remainingEnergy );
+
+      if( W_.size() == windowSize_ )
+      {
+        W_.pop_front();
+        AW_.pop_front();
+      }
+      W_.push_back( std::move(w) );
+      AW_.push_back( std::move(Aw) );
+    }
+
+    //! Remove all stored directions, i.e. if the operator changed.
+    void clear()
+    {
+      W_.clear();
+      AW_.clear();
+    }
+
+    //! Number of stored directions.
+    std::size_t size() const
+    {
+      return W_.size();
+    }
+
+    //! Maximal number of stored directions.
+    unsigned windowSize() const
+    {
+      return windowSize_;
+    }
+
+  private:
+    LinearOperator<Domain,Range>& A_;
+    SeqScalarProduct<Domain> ssp_;
+    ScalarProduct<Domain>& sp_;
+    unsigned windowSize_;
+    std::deque<Domain> W_ = {};
+    std::deque<Range> AW_ = {};
+  };
+}
+
+#endif // DUNE_PROJECTION_INITIAL_GUESS_HH
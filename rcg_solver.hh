@@ -1,6 +1,7 @@
 #ifndef DUNE_RCG_SOLVER_HH
 #define DUNE_RCG_SOLVER_HH
 
+#include <cassert>
 #include <limits>
 #include <utility>
 
@@ -17,6 +18,15 @@ namespace Dune
 {
   namespace RCGSpec
   {
+    //! Regularizations of the last solve, persistent across solves.
+    struct RegularizationStatistics
+    {
+      /// number of restarts from the initial guess after regularization
+      unsigned restarts = 0;
+      /// number of regularizations without restart (see InterfaceImpl::enableInPlaceRegularization())
+      unsigned inPlaceRegularizations = 0;
+    };
+
     //! Cache object for the regularized conjugate gradient method.
     template <class Domain, class Range>
     struct Cache : TCGSpec::Cache<Domain,Range>
@@ -24,7 +34,7 @@ namespace Dune
       template <class... Args>
       Cache(Args&&... args)
         : TCGSpec::Cache<Domain,Range>( std::forward<Args>(args)... ),
-          Pdx( this->r )
+          Pdx( this->r ), Pcorrection( this->r )
       {}
 
       void reset(LinearOperator<Domain,Range>* A,
@@ -33,26 +43,122 @@ namespace Dune
       {
         TCGSpec::Cache<Domain,Range>::reset(A,P,sp);
         Pdx = this->r;
-        doRestart = false;
+        Pcorrection *= 0;
+        correctionPcorrection = energyIncrement = 0;
+        doRestart = regularizedInPlace = false;
       }
 
       real_t<Domain> theta = 0, dxPdx = 0, minIncrease = 2, maxIncrease = 1000;
       Range Pdx;
-      bool doRestart = false;
+      /// \f$P^{-1}(x-x_0)\f$ and \f$(x-x_0,P^{-1}(x-x_0))\f$, only updated for in-place regularization
+      Range Pcorrection;
+      real_t<Domain> correctionPcorrection = 0, energyIncrement = 0;
+      bool doRestart = false, regularizeInPlace = false, regularizedInPlace = false;
+      real_t<Domain>* persistentTheta = nullptr;
+      RegularizationStatistics* statistics = nullptr;
     };
 
 
     //! Extends public interface of GenericStep for the regularized conjugate gradient method.
     template <class Cache, class Name>
-    class InterfaceImpl : public TCGSpec::InterfaceImpl<Cache,Name>
+    class InterfaceImpl : public TCGSpec::TruncationInterfaceImpl<Cache,Name>
     {
+      using real_type = typename Cache::real_type;
+
     public:
-      //!* @brief Restart the regularized conjugate gradient method after regularization.
+      void setCache(Cache* cache)
+      {
+        TCGSpec::TruncationInterfaceImpl<Cache,Name>::setCache(cache);
+        theta_ = persistentRegularization_ ? thetaDecay_ * theta_ : real_type(0);
+        cache_->theta = theta_;
+        cache_->persistentTheta = &theta_;
+        cache_->regularizeInPlace = regularizeInPlace_;
+        statistics_ = {};
+        cache_->statistics = &statistics_;
+      }
+
+      /**
+       * @brief Start subsequent solves with the regularization parameter of the previous solve.
+       *
+       * Within optimization loops the required regularization typically changes little between subsequent solves. Starting with
+       * \f$\theta_0=d\,\theta_{prev}\f$ instead of \f$\theta_0=0\f$ avoids most of the restarts, each of which discards all previous iterations.
+       * If no further regularization is required, the regularization parameter decays geometrically over subsequent solves.
+       *
+       * @param decay factor \f$d\in[0,1]\f$ for the regularization parameter \f$\theta_{prev}\f$ of the previous solve
+       */
+      void enablePersistentRegularization(real_type decay = 0.5)
+      {
+        assert( decay >= 0 && decay <= 1 );
+        persistentRegularization_ = true;
+        thetaDecay_ = decay;
+      }
+
+      //! Start each solve without regularization (default).
+      void disablePersistentRegularization()
+      {
+        persistentRegularization_ = false;
+      }
+
+      //! @brief Access regularization parameter of the current, resp. last, solve.
+      real_type regularizationParameter() const
+      {
+        return theta_;
+      }
+
+      /**
+       * @brief Regularize without restarting.
+       *
+       * Instead of restarting from the initial guess, the operator is switched to \f$A+\theta P^{-1}\f$ at the current iterate \f$x\f$.
+       * The residual is adjusted with the incrementally updated \f$P^{-1}(x-x_0)\f$ and only the search direction is rebuilt. This
+       * requires one additional vector and one additional scalar product per iteration, but keeps all previous iterations.
+       * The estimate of the energy norm of the solution is adjusted accordingly (see energyIncrement()).
+       */
+      void enableInPlaceRegularization()
+      {
+        regularizeInPlace_ = true;
+      }
+
+      //! Restart after regularization (default).
+      void disableInPlaceRegularization()
+      {
+        regularizeInPlace_ = false;
+      }
+
+      //! @brief Number of restarts from the initial guess after regularization in the current, resp. last, solve.
+      unsigned restarts() const
+      {
+        return statistics_.restarts;
+      }
+
+      //! @brief Number of regularizations without restart in the current, resp. last, solve.
+      unsigned inPlaceRegularizations() const
+      {
+        return statistics_.inPlaceRegularizations;
+      }
+
+      //!* @brief Restart the regularized conjugate gradient method after regularization. Only valid during a solve.
       bool restart() const
       {
         return cache_->doRestart;
       }
 
+      //! @brief Check if the operator has been regularized in place in the last step. Only valid during a solve.
+      bool regularizedInPlace() const
+      {
+        return cache_->regularizedInPlace;
+      }
+
+      /**
+       * @brief Increase of the squared energy norm of the correction \f$x-x_0\f$ due to in-place regularization in the last step.
+       *
+       * If the regularization parameter increases from \f$\theta\f$ to \f$\theta'\f$, this is \f$(\theta'-\theta)(x-x_0,P^{-1}(x-x_0))\f$.
+       * Only valid during a solve.
+       */
+      real_type energyIncrement() const
+      {
+        return cache_->energyIncrement;
+      }
+
       /**
        * @brief Set minimal ratio for increasing the regularization parameter, i.e. \f$\frac{\theta_{new}}{\theta_{old}}>=minIncrease\f$.
        * @param minIncrease minimal ratio for increasing the regularization parameter
@@ -74,7 +180,12 @@ namespace Dune
       }
 
     protected:
-      using TCGSpec::InterfaceImpl<Cache,Name>::cache_;
+      using TCGSpec::TruncationInterfaceImpl<Cache,Name>::cache_;
+
+    private:
+      real_type theta_ = 0, thetaDecay_ = 0.5;
+      bool persistentRegularization_ = false, regularizeInPlace_ = false;
+      RegularizationStatistics statistics_ = {};
     };
 
     /*! @cond */
@@ -100,14 +211,20 @@ namespace Dune
       template <class Cache>
       void operator()( Cache& cache ) const
       {
+        cache.regularizedInPlace = false;
+        cache.energyIncrement = 0;
+        auto firstStep = cache.firstStep;
         CGSpec::SearchDirection::operator()( cache );
 
+        // adjust preconditioned correction, i.e. P^{-1}dx = r + beta P^{-1}dx_old
+        if( !firstStep )
+        {
+          cache.Pdx *= cache.beta;
+          cache.Pdx += cache.r;
+        }
         // adjust energy norm of correction
         cache.dxPdx = cache.sp->dot(cache.dx,cache.Pdx);
         cache.dxAdx += cache.theta * cache.dxPdx;
-        // adjust preconditioned correction
-        cache.Pdx *= cache.beta;
-        cache.Pdx += cache.r;
       }
     };
 
@@ -121,6 +238,12 @@ namespace Dune
       {
         CGSpec::UpdateIterate::operator()( cache );
         cache.r.axpy(-cache.alpha*cache.theta,cache.Pdx);
+
+        if( cache.regularizeInPlace )
+        {
+          cache.correctionPcorrection += cache.alpha * ( 2*cache.sp->dot(cache.dx,cache.Pcorrection) + cache.alpha*cache.dxPdx );
+          cache.Pcorrection.axpy(cache.alpha,cache.Pdx);
+        }
       }
     };
 
@@ -143,17 +266,59 @@ namespace Dune
 
         if( verbosityLevel() > 1 )
           std::cout << "    Regularizing at nonconvexity: " << cache.dxAdx << std::endl;
+        auto previousTheta = cache.theta;
         auto oldTheta = cache.theta > 0 ? cache.theta : this->eps();
         using std::abs;
         cache.theta += (1-cache.dxAdx)/abs(cache.dxPdx);
         using std::min;
         using std::max;
         cache.theta = min(max(cache.minIncrease*oldTheta,cache.theta),cache.maxIncrease*oldTheta);
+        if( cache.persistentTheta )
+          *cache.persistentTheta = cache.theta;
         if( verbosityLevel() > 1 ) std::cout << "Updating regularization parameter from " << oldTheta << " to " << cache.theta << std::endl;
 
-        cache.alpha = 0;
         cache.operatorType = OperatorType::Indefinite;
+        if( cache.regularizeInPlace )
+        {
+          regularizeInPlace( cache, cache.theta - previousTheta );
+          return;
+        }
+
+        cache.alpha = 0;
         cache.doRestart = true;
+        if( cache.statistics )
+          ++cache.statistics->restarts;
+      }
+
+    private:
+      /// Switch to the operator \f$A+\theta P^{-1}\f$ at the current iterate and restart the recurrence for the search directions.
+      template < class Cache >
+      void regularizeInPlace( Cache& cache, real_type thetaIncrement ) const
+      {
+        cache.r.axpy(-thetaIncrement,cache.Pcorrection);
+        cache.energyIncrement += thetaIncrement * cache.correctionPcorrection;
+        cache.regularizedInPlace = true;
+        if( cache.statistics )
+          ++cache.statistics->inPlaceRegularizations;
+        if( cache.lanczosRecorder )
+          cache.lanczosRecorder->clear();
+
+        using std::abs;
+        cache.P->apply(cache.Pr,cache.r);
+        cache.sigma = abs( cache.sp->dot(cache.r,cache.Pr) );
+        cache.residualNorm = cache.sp->norm( cache.r );
+        if( cache.sigma == 0 )
+        {
+          cache.alpha = 0;
+          return;
+        }
+
+        cache.dx = cache.Pr;
+        cache.Pdx = cache.r;
+        cache.A->apply(cache.dx,cache.Adx);
+        cache.dxPdx = cache.sp->dot(cache.dx,cache.Pdx);
+        cache.dxAdx = cache.sp->dot(cache.dx,cache.Adx) + cache.theta * cache.dxPdx;
+        operator()( cache );
       }
     };
 
@@ -180,6 +345,8 @@ namespace Dune
 
     Regularizes if a conjugate search direction \f$\delta x\f$ of non-positive curvature is encountered, i.e. if \f$\delta xA\delta x\le 0\f$.
     In this case the operator \f$A\f$ is replaced by the operator \f$A+\theta P\f$, where \f$\theta\f$ is a monotone increasing regularization parameter.
+    By default the iteration is restarted from the initial guess after each regularization. With
+    RCGSpec::InterfaceImpl::enableInPlaceRegularization() the iteration continues at the current iterate instead.
 
     @tparam Domain domain space \f$X\f$
     @tparam Range range space \f$Y\f$
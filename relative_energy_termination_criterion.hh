@@ -25,7 +25,9 @@ namespace Dune
       criterion @cite Arioli2004).
 
       Requires that CG starts at \f$ x = 0 \f$. More general starting values might be used, but must be chosen such that
-      the estimate for the energy norm of the solution stays positive (see the above mentioned paper for details).
+      the estimate for the energy norm of the solution stays positive (see the above mentioned paper for details). If the starting value
+      \f$x_0\f$ is a Galerkin projection of the solution, such as computed by ProjectionInitialGuess, then \f$\|x\|_A^2=\|x_0\|_A^2+\|x-x_0\|_A^2\f$
+      and the estimate stays valid if \f$\|x_0\|_A^2\f$ is provided with setInitialEnergy().
 
       The essential idea behind this termination criterion is simple: perform \f$d\f$ extra iterations of the conjugate gradient
       method to estimate the absolute or relative error in the energy norm (the parameter \f$d\f$ can be adjusted with setLookAhead()).
@@ -147,7 +149,8 @@ namespace Dune
       void init()
       {
         scaledGamma2.clear();
-        energyNorm2 = stepLength2 = 0;
+        energyNorm2 = initialEnergyNorm2;
+        stepLength2 = 0;
         watch.reset();
         watch.start();
       }
@@ -160,6 +163,31 @@ namespace Dune
         return sqrt( squaredRelativeError() );
       }
 
+      /*!
+        @brief Set the squared energy norm \f$(x_0,Ax_0)\f$ of a Galerkin-projected initial guess (default = 0).
+
+        Is taken into account in the estimate of the energy norm of the solution in all subsequent solves.
+
+        @param energy squared energy norm of the initial guess
+       */
+      void setInitialEnergy(real_type energy)
+      {
+        initialEnergyNorm2 = energy;
+      }
+
+      /*!
+        @brief Restart the error estimate after the operator has been regularized in place (see RCGSpec::InterfaceImpl::enableInPlaceRegularization()).
+
+        Discards the history of the error estimate, which refers to the previous operator, and keeps the estimate of the energy norm of the solution.
+
+        @param energyIncrement increase of the squared energy norm of the current correction due to the regularization
+       */
+      void restartEnergyEstimate(real_type energyIncrement)
+      {
+        scaledGamma2.clear();
+        energyNorm2 += energyIncrement;
+      }
+
       /*!
         @brief Set the additional CG-iterations required for estimating the relative energy error.
 
@@ -228,6 +256,7 @@ namespace Dune
       unsigned lookAhead_ = 25;
       std::vector<real_type> scaledGamma2 = std::vector<real_type>{ };
       real_type energyNorm2 = 0;
+      real_type initialEnergyNorm2 = 0;
       real_type stepLength2 = 0;
       TypeErasedCGHolder step_ = { };
       Timer watch = Timer{ false };
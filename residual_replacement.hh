@@ -0,0 +1,337 @@
+#ifndef DUNE_RESIDUAL_REPLACEMENT_HH
+#define DUNE_RESIDUAL_REPLACEMENT_HH
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <limits>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <dune/common/timer.hh>
+#include <dune/common/typetraits.hh>
+
+#include "cg_solver.hh"
+#include "generic_iterative_method.hh"
+#include "generic_step.hh"
+#include "relative_energy_termination_criterion.hh"
+
+namespace Dune
+{
+  namespace ResidualReplacementSpec
+  {
+    //! Settings and costs of the residual replacement, persistent across solves.
+    template <class real_type>
+    struct Statistics
+    {
+      /// monitor the gap and replace the residual, if false the update is not modified
+      bool active = true;
+      /// estimate of \f$\|A\|\f$, if not positive it is estimated from \f$\|A\delta x\|/\|\delta x\|\f$
+      real_type operatorNorm = 0;
+      /// unit roundoff of the update, if not positive the machine epsilon of the floating point type of the update is used
+      real_type unitRoundoff = 0;
+      /// number of replacements, i.e. of additional applications of the operator, in the last solve
+      unsigned replacements = 0;
+      /// number of additional norms for monitoring the gap and replacing the residual in the last solve
+      unsigned reductions = 0;
+      /// time spent for replacing the residual in the last solve
+      double elapsed = 0;
+    };
+
+
+    /**
+     * @brief Norms of the search direction and its image, as required by UpdateIterate.
+     *
+     * Uses the scalar product of the cache. Specialize for caches that store the search direction in other vector types
+     * (see MixedPrecisionCGSpec).
+     */
+    template <class BaseCache>
+    struct SearchDirectionNorms
+    {
+      using real_type = typename BaseCache::real_type;
+
+      /// \f$\|\delta x\|\f$
+      static real_type dx(const BaseCache& cache)
+      {
+        return cache.sp->norm( cache.dx );
+      }
+
+      /// \f$\|A\delta x\|\f$
+      static real_type Adx(const BaseCache& cache)
+      {
+        return cache.sp->norm( cache.Adx );
+      }
+    };
+
+
+    /**
+     * @brief Extends the cache of a conjugate gradient method by the data required for the residual replacement.
+     *
+     * Refers to the copy of the right hand side that is stored in InterfaceImpl and holds the estimate of the gap between updated
+     * and true residual, measured in multiples of the unit roundoff \f$\varepsilon\f$, and an upper bound of \f$\|x\|\f$.
+     */
+    template <class Domain, class Range, class BaseCache_ = CGSpec::Cache<Domain,Range> >
+    struct Cache : BaseCache_
+    {
+      using BaseCache = BaseCache_;
+      using real_type = typename BaseCache::real_type;
+
+      Cache( Domain& x0, Range& b0 )
+        : BaseCache(x0,b0)
+      {}
+
+      void reset(LinearOperator<Domain,Range>* A,
+                Preconditioner<Domain,Range>* P,
+                ScalarProduct<Domain>* sp)
+      {
+        BaseCache::reset(A,P,sp);
+        operatorNormEstimate = 0;
+        gapIsCurrent = true;
+        if( !statistics )
+          return;
+
+        statistics->replacements = statistics->reductions = 0;
+        statistics->elapsed = 0;
+        if( !statistics->active )
+          return;
+
+        operatorNormEstimate = statistics->operatorNorm;
+        iterateNorm = this->sp->norm(this->x);
+        ++statistics->reductions;
+        previousResidualNorm = this->residualNorm;
+        gap = initialGap = operatorNormEstimate * iterateNorm + this->residualNorm;
+      }
+
+      /// right hand side for the computation of the true residual, stored in InterfaceImpl
+      const Range* b = nullptr;
+      /// \f$d_k/\varepsilon\f$ and \f$d_{init}/\varepsilon\f$ in the notation of @cite VanDerVorst2000
+      real_type gap = 0, initialGap = 0;
+      /// residual norm that corresponds to gap
+      real_type previousResidualNorm = 0;
+      /// upper bound of \f$\|x\|\f$
+      real_type iterateNorm = 0;
+      real_type operatorNormEstimate = 0;
+      /// true if gap refers to the current iterate
+      bool gapIsCurrent = true;
+      Statistics<real_type>* statistics = nullptr;
+    };
+
+
+    //! @cond
+    class Name
+    {
+    public:
+      std::string name() const
+      {
+        return "Conjugate Gradients with Residual Replacement";
+      }
+    };
+    //! @endcond
+
+
+    /**
+     * @brief Extends public interface of GenericStep by settings and costs of the residual replacement.
+     *
+     * Stores a copy of the right hand side, which is reused across solves.
+     */
+    template <class Cache, class Name, class Base = CGSpec::InterfaceImpl<Cache,Name> >
+    class InterfaceImpl : public Base
+    {
+      using real_type = typename Cache::real_type;
+      using Range = typename std::decay< decltype(std::declval<Cache>().r) >::type;
+
+    public:
+      void setCache(Cache* cache)
+      {
+        Base::setCache(cache);
+        cache_->statistics = &statistics_;
+        cache_->b = nullptr;
+        if( !statistics_.active )
+          return;
+
+        // the residual is initialized with the right hand side when the cache is reset
+        rhs_.assign( 1, cache_->r );
+        cache_->b = &rhs_.front();
+      }
+
+      //! Monitor the gap between updated and true residual and replace the residual if necessary (default).
+      void enableResidualReplacement()
+      {
+        statistics_.active = true;
+      }
+
+      //! Do not monitor the gap between updated and true residual, i.e. perform the update without additional costs.
+      void disableResidualReplacement()
+      {
+        statistics_.active = false;
+      }
+
+      /**
+       * @brief Set estimate of the operator norm \f$\|A\|\f$ that enters the estimate of the residual gap.
+       *
+       * If not set (or not positive), \f$\|A\|\f$ is estimated from below by \f$\max_k \|A\delta x_k\|/\|\delta x_k\|\f$, which costs
+       * one additional norm per step.
+       */
+      void setOperatorNorm(real_type operatorNorm)
+      {
+        statistics_.operatorNorm = operatorNorm;
+      }
+
+      /**
+       * @brief Set unit roundoff \f$\varepsilon\f$ of the recursive update, which determines when residuals are replaced.
+       *
+       * Defaults to the machine epsilon of the floating point type of the update (see UpdateIterate). Independent of the maximal
+       * attainable accuracy of the iterative method (see Mixin::Eps).
+       */
+      void setUnitRoundoff(real_type unitRoundoff)
+      {
+        statistics_.unitRoundoff = unitRoundoff;
+      }
+
+      //! Number of residual replacements in the last solve. Each replacement costs one application of the operator.
+      unsigned residualReplacements() const
+      {
+        return statistics_.replacements;
+      }
+
+      //! Number of additional norms, i.e. global reductions, for monitoring the gap and replacing the residual in the last solve.
+      unsigned residualReplacementReductions() const
+      {
+        return statistics_.reductions;
+      }
+
+      //! Time in seconds spent for replacing the residual in the last solve.
+      double residualReplacementTime() const
+      {
+        return statistics_.elapsed;
+      }
+
+    protected:
+      using Base::cache_;
+
+    private:
+      Statistics<real_type> statistics_ = {};
+      /// holds at most one vector, such that the interface remains copyable
+      std::vector<Range> rhs_ = {};
+    };
+
+
+    //! Bind template arguments of ResidualReplacementSpec::InterfaceImpl for the conjugate gradient method.
+    template <class Domain, class Range>
+    using Interface = InterfaceImpl< Cache<Domain,Range>, Name >;
+
+
+    /**
+     * @brief Update iterate and residual, replace the updated residual by the true residual \f$b-Ax\f$ if the estimated gap between
+     * both becomes too large (see @cite VanDerVorst2000).
+     *
+     * The gap is estimated by \f$d_k = d_{k-1} + \varepsilon(\|A\|\|x_k\|+\|r_k\|)\f$, where \f$\varepsilon\f$ is the unit roundoff of
+     * the update (see InterfaceImpl::setUnitRoundoff()). The residual is replaced if \f$d_{k-1}\le\sqrt\varepsilon\|r_{k-1}\|\f$, \f$d_k>\sqrt\varepsilon\|r_k\|\f$
+     * and \f$d_k>1.1d_{init}\f$, where \f$d_{init}\f$ is the gap after the last replacement.
+     *
+     * The check for \f$x_k\f$ is performed before the next update, such that it reuses \f$\|r_k\|\f$ from the application of the
+     * preconditioner. \f$\|x_k\|\f$ is bounded by \f$\|x_{k-1}\|+|\alpha_{k-1}|\|\delta x_{k-1}\|\f$ and only evaluated after replacements.
+     * This costs one additional norm per step (two if \f$\|A\|\f$ is estimated) and one application of the operator and two norms per replacement.
+     *
+     * @tparam Update update of iterate and residual, such as CGSpec::UpdateIterate
+     * @tparam real_type floating point type of the update, its machine epsilon is the default unit roundoff
+     */
+    template <class Update = CGSpec::UpdateIterate, class real_type = double>
+    class UpdateIterate : public Update
+    {
+    public:
+      template < class Cache >
+      void operator()( Cache& cache ) const
+      {
+        if( !cache.statistics || !cache.statistics->active )
+        {
+          Update::operator()( cache );
+          return;
+        }
+
+        if( !cache.gapIsCurrent )
+          replaceResidualIfNecessary( cache );
+
+        using Norms = SearchDirectionNorms< typename Cache::BaseCache >;
+        using std::abs;
+        auto dxNorm = Norms::dx( cache );
+        ++cache.statistics->reductions;
+        if( cache.statistics->operatorNorm <= 0 && dxNorm > 0 )
+        {
+          cache.operatorNormEstimate = std::max( cache.operatorNormEstimate, Norms::Adx( cache ) / dxNorm );
+          ++cache.statistics->reductions;
+        }
+        cache.iterateNorm += abs( cache.alpha ) * dxNorm;
+
+        Update::operator()( cache );
+        cache.gapIsCurrent = false;
+      }
+
+    private:
+      /// Check the gap for the current iterate, cache.residualNorm has been computed by the preconditioning substep.
+      template < class Cache >
+      void replaceResidualIfNecessary( Cache& cache ) const
+      {
+        auto residualNorm = cache.residualNorm;
+        auto previousGap = cache.gap;
+        cache.gap += cache.operatorNormEstimate * cache.iterateNorm + residualNorm;
+
+        using std::sqrt;
+        auto unitRoundoff = cache.statistics->unitRoundoff > 0 ? cache.statistics->unitRoundoff
+                                                               : typename Cache::real_type( std::numeric_limits<real_type>::epsilon() );
+        auto sqrtEps = sqrt( unitRoundoff );
+        if( sqrtEps * previousGap <= cache.previousResidualNorm &&
+            sqrtEps * cache.gap > residualNorm &&
+            cache.gap > 1.1 * cache.initialGap )
+        {
+          assert( cache.b );
+          auto watch = Timer{};
+          cache.r = *cache.b;
+          cache.A->applyscaleadd( -1, cache.x, cache.r );
+          cache.iterateNorm = cache.sp->norm( cache.x );
+          residualNorm = cache.residualNorm = cache.sp->norm( cache.r );
+          cache.gap = cache.initialGap = cache.operatorNormEstimate * cache.iterateNorm + residualNorm;
+          ++cache.statistics->replacements;
+          cache.statistics->reductions += 2;
+          cache.statistics->elapsed += watch.stop();
+        }
+
+        cache.previousResidualNorm = residualNorm;
+        cache.gapIsCurrent = true;
+      }
+    };
+
+
+    //! Step implementation for the conjugate gradient method with residual replacement.
+    template <class Domain, class Range=Domain>
+    using Step =
+    GenericStep< Domain, Range,
+      CGSpec::ApplyPreconditioner,
+      CGSpec::SearchDirection,
+      CGSpec::Scaling,
+      UpdateIterate< CGSpec::UpdateIterate, real_t<Domain> >,
+      Interface< Domain, Range >
+    >;
+  }
+
+
+  /*!
+    @ingroup ISTL_Solvers
+    @brief Conjugate gradient method with residual replacement (see @cite Hestenes1952, @cite VanDerVorst2000).
+
+    Bounds the gap between the recursively updated residual and the true residual \f$b-Ax\f$, which otherwise limits the attainable
+    accuracy. The replacement strategy is implemented as Update substep (ResidualReplacementSpec::UpdateIterate) and can be combined
+    with other variants of the conjugate gradient method.
+
+    @tparam Domain domain space \f$X\f$
+    @tparam Range range space \f$Y\f$
+    @tparam TerminationCriterion termination criterion (such as Dune::KrylovTerminationCriterion::ResidualBased or Dune::KrylovTerminationCriterion::RelativeEnergyError (default))
+   */
+  template <class Domain, class Range,
+            template <class> class TerminationCriterion = KrylovTerminationCriterion::RelativeEnergyError>
+  using ResidualReplacementCGSolver = GenericIterativeMethod< ResidualReplacementSpec::Step<Domain,Range> , TerminationCriterion< real_t<Domain> > >;
+}
+
+#endif // DUNE_RESIDUAL_REPLACEMENT_HH
@@ -0,0 +1,106 @@
+#ifndef DUNE_SOLVER_CONTROL_HH
+#define DUNE_SOLVER_CONTROL_HH
+
+#include <atomic>
+#include <limits>
+
+namespace Dune
+{
+  /**
+   * @brief Cooperative cancellation of GenericIterativeMethod::apply() from other threads.
+   *
+   * The token is checked once per iteration (see GenericIterativeMethod::setCancellationToken()). A cancelled solve returns the current
+   * iterate with SolverStatus::Cancelled.
+   */
+  class CancellationToken
+  {
+  public:
+    CancellationToken() = default;
+    CancellationToken(const CancellationToken&) = delete;
+    CancellationToken& operator=(const CancellationToken&) = delete;
+
+    //! Request cancellation, may be called from any thread.
+    void cancel() noexcept
+    {
+      cancelled_.store(true,std::memory_order_release);
+    }
+
+    //! Allow subsequent solves to run.
+    void reset() noexcept
+    {
+      cancelled_.store(false,std::memory_order_release);
+    }
+
+    //! @return true if cancellation has been requested
+    bool cancelled() const noexcept
+    {
+      return cancelled_.load(std::memory_order_acquire);
+    }
+
+  private:
+    std::atomic<bool> cancelled_{false};
+  };
+
+
+  /**
+   * @brief Progress of a running solve, readable from other threads without locks.
+   *
+   * Written by GenericIterativeMethod after each iteration (see GenericIterativeMethod::setProgress()). Consistent snapshots are
+   * obtained with a sequence lock: the solver never waits for readers, and readers only retry if they overlap with an update.
+   * At most one solver may write to an object of this class at a time.
+   */
+  class SolverProgress
+  {
+  public:
+    struct Snapshot
+    {
+      /// iterations since the last (re-)start
+      unsigned iteration = 0;
+      /// error estimate of the termination criterion
+      double errorEstimate = std::numeric_limits<double>::quiet_NaN();
+      /// regularization parameter \f$\theta\f$ of RCG and TRCG, zero for other methods
+      double regularizationParameter = 0;
+    };
+
+    SolverProgress() = default;
+    SolverProgress(const SolverProgress&) = delete;
+    SolverProgress& operator=(const SolverProgress&) = delete;
+
+    //! Read progress, may be called from any thread.
+    Snapshot snapshot() const noexcept
+    {
+      Snapshot result;
+      while( true )
+      {
+        auto sequence = sequence_.load(std::memory_order_acquire);
+        if( sequence % 2 == 0 )
+        {
+          result.iteration = iteration_.load(std::memory_order_relaxed);
+          result.errorEstimate = errorEstimate_.load(std::memory_order_relaxed);
+          result.regularizationParameter = regularizationParameter_.load(std::memory_order_relaxed);
+          std::atomic_thread_fence(std::memory_order_acquire);
+          if( sequence_.load(std::memory_order_relaxed) == sequence )
+            return result;
+        }
+      }
+    }
+
+    //! Publish progress, only called by the solver.
+    void publish(unsigned iteration, double errorEstimate, double regularizationParameter) noexcept
+    {
+      auto sequence = sequence_.load(std::memory_order_relaxed);
+      sequence_.store(sequence+1,std::memory_order_relaxed);
+      std::atomic_thread_fence(std::memory_order_release);
+      iteration_.store(iteration,std::memory_order_relaxed);
+      errorEstimate_.store(errorEstimate,std::memory_order_relaxed);
+      regularizationParameter_.store(regularizationParameter,std::memory_order_relaxed);
+      sequence_.store(sequence+2,std::memory_order_release);
+    }
+
+  private:
+    std::atomic<unsigned> sequence_{0}, iteration_{0};
+    std::atomic<double> errorEstimate_{std::numeric_limits<double>::quiet_NaN()}, regularizationParameter_{0};
+  };
+}
+
+#endif // DUNE_SOLVER_CONTROL_HH
@@ -0,0 +1,224 @@
+#ifndef DUNE_SPECTRAL_BOUNDS_HH
+#define DUNE_SPECTRAL_BOUNDS_HH
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <dune/common/typetraits.hh>
+#include "symmetric_eigenvalue_problem.hh"
+
+namespace Dune
+{
+  //! Finite elements for which bounds on the spectrum of the Jacobi-preconditioned mass matrix are available.
+  enum class MassMatrixElement { TriangleP1, TetrahedronP1, QuadrilateralQ1, HexahedronQ1, PrismP1, TriangleP2, TetrahedronP2 };
+
+  /**
+   * @brief Guaranteed bounds on the spectrum of Jacobi-preconditioned operators.
+   *
+   * The computed bounds can directly be passed to ChebyshevSemiIterationStep::setSpectralBounds().
+   */
+  namespace SpectralBounds
+  {
+    //! @cond
+    namespace Detail
+    {
+      inline unsigned defaultNumberOfThreads()
+      {
+        return std::max( 1u, std::thread::hardware_concurrency() );
+      }
+
+      /// Call f(begin,end,thread) for nThreads contiguous chunks of [0,size) in parallel.
+      template <class Function>
+      void parallelFor(std::size_t size, unsigned nThreads, Function f)
+      {
+        nThreads = static_cast<unsigned>( std::max<std::size_t>( 1, std::min<std::size_t>( nThreads, size ) ) );
+        if( nThreads == 1 )
+        {
+          f( std::size_t(0), size, 0u );
+          return;
+        }
+
+        std::vector<std::thread> threads;
+        threads.reserve( nThreads );
+        for( auto thread = 0u; thread < nThreads; ++thread )
+          threads.emplace_back( f, thread*size/nThreads, (thread+1)*size/nThreads, thread );
+        for( auto& thread : threads )
+          thread.join();
+      }
+
+      /// Combine bounds of different threads.
+      template <class real_type>
+      std::pair<real_type,real_type> merge(const std::vector< std::pair<real_type,real_type> >& bounds)
+      {
+        auto result = std::make_pair( std::numeric_limits<real_type>::max(), std::numeric_limits<real_type>::lowest() );
+        for( const auto& bound : bounds )
+        {
+          if( bound.first > bound.second && bound.first != std::numeric_limits<real_type>::max() )
+            throw std::runtime_error("Nonpositive diagonal entry in the computation of spectral bounds for the Jacobi preconditioner.");
+          result.first = std::min( result.first, bound.first );
+          result.second = std::max( result.second, bound.second );
+        }
+        return result;
+      }
+    }
+    //! @endcond
+
+
+    /**
+     * @brief Gershgorin bounds for the spectrum of the Jacobi-preconditioned matrix \f$D^{-1}A\f$.
+     *
+     * The spectrum is contained in \f$[\min_i(1-R_i),\max_i(1+R_i)]\f$ with \f$R_i=\sum_{j\neq i}|a_{ij}|/a_{ii}\f$. For block matrices
+     * the (scalar) point-Jacobi preconditioner is considered. Rows are processed in parallel.
+     *
+     * @param A assembled matrix with positive diagonal entries (such as BCRSMatrix)
+     * @param nThreads number of threads
+     * @return lower and upper bound of the spectrum
+     */
+    template <class Matrix>
+    std::pair< real_t<typename Matrix::field_type>, real_t<typename Matrix::field_type> >
+    gershgorinJacobi(const Matrix& A, unsigned nThreads = Detail::defaultNumberOfThreads())
+    {
+      using real_type = real_t<typename Matrix::field_type>;
+      const auto invalid = std::make_pair( std::numeric_limits<real_type>::max(), std::numeric_limits<real_type>::lowest() );
+      std::vector< std::pair<real_type,real_type> > bounds( std::max( 1u, nThreads ), invalid );
+
+      Detail::parallelFor( A.N(), nThreads, [&A,&bounds]( std::size_t begin, std::size_t end, unsigned thread )
+      {
+        using std::abs;
+        auto& bound = bounds[thread];
+        std::vector<real_type> diagonal, radius;
+        for( auto i = begin; i < end; ++i )
+        {
+          const auto& row = A[i];
+          if( row.begin() == row.end() )
+            continue;
+          diagonal.assign( row.begin()->N(), real_type(0) );
+          radius.assign( diagonal.size(), real_type(0) );
+
+          for( auto col = row.begin(); col != row.end(); ++col )
+          {
+            const auto& block = *col;
+            for( std::size_t k = 0; k < block.N(); ++k )
+              for( std::size_t l = 0; l < block.M(); ++l )
+              {
+                if( col.index() == i && k == l )
+                  diagonal[k] = block[k][l];
+                else
+                  radius[k] += abs( block[k][l] );
+              }
+          }
+
+          for( std::size_t k = 0; k < diagonal.size(); ++k )
+          {
+            // mark as invalid
+            if( !( diagonal[k] > 0 ) )
+            {
+              bound = std::make_pair( real_type(1), real_type(0) );
+              return;
+            }
+            bound.first = std::min( bound.first, 1 - radius[k]/diagonal[k] );
+            bound.second = std::max( bound.second, 1 + radius[k]/diagonal[k] );
+          }
+        }
+      });
+
+      return Detail::merge( bounds );
+    }
+
+
+    /**
+     * @brief Element-wise bounds for the spectrum of the Jacobi-preconditioned assembled matrix \f$D^{-1}A\f$, where \f$A=\sum_e A_e\f$.
+     *
+     * The spectrum is contained in \f$[\min_e\lambda_{min}(D_e^{-1}A_e),\max_e\lambda_{max}(D_e^{-1}A_e)]\f$, where \f$D_e\f$ denotes
+     * the diagonal of the element matrix \f$A_e\f$ (see @cite Wathen1987). The small dense eigenvalue problems are solved with the cyclic
+     * Jacobi method. Elements are processed in parallel.
+     *
+     * @param elementMatrices random access container of symmetric positive definite element matrices (such as FieldMatrix or DynamicMatrix)
+     * @param nThreads number of threads
+     * @return lower and upper bound of the spectrum
+     */
+    template <class ElementMatrices>
+    std::pair< real_t<typename ElementMatrices::value_type::field_type>, real_t<typename ElementMatrices::value_type::field_type> >
+    elementwiseJacobi(const ElementMatrices& elementMatrices, unsigned nThreads = Detail::defaultNumberOfThreads())
+    {
+      using real_type = real_t<typename ElementMatrices::value_type::field_type>;
+      const auto invalid = std::make_pair( std::numeric_limits<real_type>::max(), std::numeric_limits<real_type>::lowest() );
+      std::vector< std::pair<real_type,real_type> > bounds( std::max( 1u, nThreads ), invalid );
+
+      Detail::parallelFor( elementMatrices.size(), nThreads, [&elementMatrices,&bounds]( std::size_t begin, std::size_t end, unsigned thread )
+      {
+        using std::sqrt;
+        auto& bound = bounds[thread];
+        std::vector<real_type> scaledMatrix, scaling;
+        for( auto e = begin; e < end; ++e )
+        {
+          const auto& elementMatrix = elementMatrices[e];
+          const auto n = elementMatrix.N();
+          scaling.resize( n );
+          for( std::size_t i = 0; i < n; ++i )
+          {
+            // mark as invalid
+            if( !( elementMatrix[i][i] > 0 ) )
+            {
+              bound = std::make_pair( real_type(1), real_type(0) );
+              return;
+            }
+            scaling[i] = 1/sqrt( elementMatrix[i][i] );
+          }
+
+          scaledMatrix.resize( n*n );
+          for( std::size_t i = 0; i < n; ++i )
+            for( std::size_t j = 0; j < n; ++j )
+              scaledMatrix[i*n+j] = scaling[i] * elementMatrix[i][j] * scaling[j];
+
+          auto eigenvalues = symmetricEigenvalueProblem( scaledMatrix, n );
+          bound.first = std::min( bound.first, eigenvalues.front() );
+          bound.second = std::max( bound.second, eigenvalues.back() );
+        }
+      });
+
+      return Detail::merge( bounds );
+    }
+
+
+    /**
+     * @brief Bounds for the spectrum of the Jacobi-preconditioned mass matrix.
+     *
+     * Element-wise bounds (see elementwiseJacobi()) for the reference elements. For simplicial elements these do not depend on the
+     * geometry. For quadrilateral, hexahedral and prismatic elements they hold for affine elements (parallelograms, parallelepipeds and
+     * straight prisms). The bounds for the P2 elements are outward-rounded numerical values.
+     *
+     * @param element finite element
+     * @return lower and upper bound of the spectrum
+     */
+    inline std::pair<double,double> massMatrixJacobi(MassMatrixElement element)
+    {
+      switch( element )
+      {
+      case MassMatrixElement::TriangleP1:
+        return std::make_pair( 0.5, 2.0 );
+      case MassMatrixElement::TetrahedronP1:
+        return std::make_pair( 0.5, 2.5 );
+      case MassMatrixElement::QuadrilateralQ1:
+        return std::make_pair( 0.25, 2.25 );
+      case MassMatrixElement::HexahedronQ1:
+        return std::make_pair( 0.125, 3.375 );
+      case MassMatrixElement::PrismP1:
+        return std::make_pair( 0.25, 3.0 );
+      case MassMatrixElement::TriangleP2:
+        return std::make_pair( 0.3923, 2.0599 );
+      case MassMatrixElement::TetrahedronP2:
+        return std::make_pair( 0.2499, 4.3475 );
+      }
+      throw std::invalid_argument("Unknown element in the computation of spectral bounds for the mass matrix.");
+    }
+  }
+}
+
+#endif // DUNE_SPECTRAL_BOUNDS_HH
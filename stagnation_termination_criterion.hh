@@ -0,0 +1,130 @@
+#ifndef DUNE_STAGNATION_TERMINATION_CRITERION_HH
+#define DUNE_STAGNATION_TERMINATION_CRITERION_HH
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <dune/common/typetraits.hh>
+
+namespace Dune
+{
+  namespace KrylovTerminationCriterion
+  {
+    //! @cond
+    namespace Detail
+    {
+      /// Check if Args is a single argument of type Self, resp. derived from Self, i.e. if a copy constructor is required.
+      template <class Self, class... Args>
+      struct IsCopy : std::false_type
+      {};
+
+      template <class Self, class Arg>
+      struct IsCopy<Self,Arg> : std::is_base_of< Self, typename std::decay<Arg>::type >
+      {};
+    }
+    //! @endcond
+
+    /*!
+      @ingroup ISTL_Solvers
+      @brief Adds stagnation detection to a termination criterion.
+
+      Terminates if the underlying criterion is satisfied, or if the best error estimate did not decrease by at least the factor
+      \f$\rho\f$ within the last \f$w\f$ iterations, i.e. if
+      \f[ \min_{j\le k}\varepsilon_j \ge \rho\min_{j\le k-w}\varepsilon_j. \f]
+      In the latter case stagnated() returns true and GenericIterativeMethod reports SolverStatus::Stagnated.
+      Iterations without finite error estimate (i.e. during the look-ahead of RelativeEnergyError) are ignored.
+
+      Derives from the underlying criterion, such that its mixins and member functions remain accessible:
+      @code{.cpp}
+      using Criterion = KrylovTerminationCriterion::Stagnation< KrylovTerminationCriterion::ResidualBased<double> >;
+      auto cg = MyCGSolver<Domain,Range>(A,P,sp,Criterion(1e-8));
+      @endcode
+
+      @tparam Criterion termination criterion, such as ResidualBased or RelativeEnergyError
+     */
+    template <class Criterion>
+    class Stagnation : public Criterion
+    {
+    public:
+      using real_type = real_t<decltype(std::declval<Criterion>().errorEstimate())>;
+
+      //! Constructor, forwards all arguments to the underlying criterion.
+      template <class... Args,
+                typename std::enable_if< !Detail::IsCopy<Stagnation,Args...>::value >::type* = nullptr>
+      Stagnation(Args&&... args)
+        : Criterion( std::forward<Args>(args)... )
+      {}
+
+      //! @copydoc ResidualBased::init()
+      void init()
+      {
+        Criterion::init();
+        first_ = size_ = 0;
+        stagnated_ = false;
+      }
+
+      //! @return true if the underlying criterion is satisfied or stagnation is detected
+      operator bool()
+      {
+        if( Criterion::operator bool() )
+          return true;
+
+        using std::isfinite;
+        auto errorEstimate = Criterion::errorEstimate();
+        if( !isfinite( errorEstimate ) || errorEstimate == std::numeric_limits<real_type>::max() )
+          return false;
+
+        // ring buffer of the best error estimates of the last window_+1 iterations
+        using std::min;
+        auto capacity = bestErrorEstimates_.size();
+        auto last = ( first_ + size_ ) % capacity;
+        if( size_ > 0 )
+          errorEstimate = min( errorEstimate, bestErrorEstimates_[ ( last + capacity - 1 ) % capacity ] );
+        bestErrorEstimates_[last] = errorEstimate;
+        if( ++size_ <= window_ )
+          return false;
+
+        stagnated_ = bestErrorEstimates_[last] >= reductionFactor_ * bestErrorEstimates_[first_];
+        first_ = ( first_ + 1 ) % capacity;
+        --size_;
+        return stagnated_;
+      }
+
+      /*!
+        @brief Set window for stagnation detection.
+        @param window number of iterations \f$w\f$ (default = 50)
+        @param reductionFactor required reduction \f$\rho\in(0,1]\f$ of the error estimate within the window (default = 0.99)
+       */
+      void setStagnationWindow(unsigned window, real_type reductionFactor = 0.99)
+      {
+        assert( window > 0 );
+        assert( reductionFactor > 0 && reductionFactor <= 1 );
+        window_ = window;
+        reductionFactor_ = reductionFactor;
+        bestErrorEstimates_.assign( window_ + 1, real_type(0) );
+        first_ = size_ = 0;
+      }
+
+      //! @return true if the last iteration has been terminated due to stagnation
+      bool stagnated() const
+      {
+        return stagnated_;
+      }
+
+    private:
+      unsigned window_ = 50;
+      std::vector<real_type> bestErrorEstimates_ = std::vector<real_type>( window_ + 1 );
+      std::size_t first_ = 0, size_ = 0;
+      real_type reductionFactor_ = 0.99;
+      bool stagnated_ = false;
+    };
+  }
+}
+
+#endif // DUNE_STAGNATION_TERMINATION_CRITERION_HH
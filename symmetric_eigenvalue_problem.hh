@@ -0,0 +1,104 @@
+#ifndef DUNE_SYMMETRIC_EIGENVALUE_PROBLEM_HH
+#define DUNE_SYMMETRIC_EIGENVALUE_PROBLEM_HH
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <numeric>
+#include <vector>
+
+namespace Dune
+{
+  /**
+   * @brief Solve a small dense symmetric eigenvalue problem \f$AV=V\Lambda\f$ with the cyclic Jacobi method.
+   *
+   * Intended for the tiny eigenvalue problems that arise in Rayleigh-Ritz procedures and in the computation of element-wise
+   * spectral bounds.
+   *
+   * @param A row-wise stored symmetric matrix, is overwritten
+   * @param n number of rows
+   * @param eigenvectors if not null, contains the row-wise stored matrix \f$V\f$ on exit, i.e. the k-th eigenvector is stored in the k-th column
+   * @return eigenvalues in ascending order
+   */
+  template <class real_type>
+  std::vector<real_type> symmetricEigenvalueProblem(std::vector<real_type>& A, std::size_t n, std::vector<real_type>* eigenvectors = nullptr)
+  {
+    using std::abs;
+    using std::sqrt;
+    const auto eps = std::numeric_limits<real_type>::epsilon();
+
+    auto V = std::vector<real_type>{};
+    if( eigenvectors )
+    {
+      V.assign( n*n, real_type(0) );
+      for( std::size_t i = 0; i < n; ++i )
+        V[i*n+i] = 1;
+    }
+
+    for( auto sweep = 0u; sweep < 50u; ++sweep )
+    {
+      real_type offDiagonal = 0, diagonal = 0;
+      for( std::size_t p = 0; p < n; ++p )
+      {
+        diagonal += A[p*n+p] * A[p*n+p];
+        for( std::size_t q = p+1; q < n; ++q )
+          offDiagonal += A[p*n+q] * A[p*n+q];
+      }
+      if( offDiagonal <= eps * eps * diagonal )
+        break;
+
+      for( std::size_t p = 0; p < n; ++p )
+        for( std::size_t q = p+1; q < n; ++q )
+        {
+          if( A[p*n+q] == 0 )
+            continue;
+
+          auto theta = ( A[q*n+q] - A[p*n+p] ) / ( 2 * A[p*n+q] );
+          auto t = ( theta >= 0 ? real_type(1) : real_type(-1) ) / ( abs(theta) + sqrt( theta*theta + 1 ) );
+          auto c = 1 / sqrt( t*t + 1 );
+          auto s = t * c;
+
+          for( std::size_t k = 0; k < n; ++k )
+          {
+            auto akp = A[k*n+p], akq = A[k*n+q];
+            A[k*n+p] = c*akp - s*akq;
+            A[k*n+q] = s*akp + c*akq;
+          }
+          for( std::size_t k = 0; k < n; ++k )
+          {
+            auto apk = A[p*n+k], aqk = A[q*n+k];
+            A[p*n+k] = c*apk - s*aqk;
+            A[q*n+k] = s*apk + c*aqk;
+          }
+          if( eigenvectors )
+            for( std::size_t k = 0; k < n; ++k )
+            {
+              auto vkp = V[k*n+p], vkq = V[k*n+q];
+              V[k*n+p] = c*vkp - s*vkq;
+              V[k*n+q] = s*vkp + c*vkq;
+            }
+        }
+    }
+
+    auto order = std::vector<std::size_t>( n );
+    std::iota( begin(order), end(order), std::size_t(0) );
+    std::sort( begin(order), end(order), [&A,n]( std::size_t i, std::size_t j ) { return A[i*n+i] < A[j*n+j]; } );
+
+    auto eigenvalues = std::vector<real_type>( n );
+    for( std::size_t i = 0; i < n; ++i )
+      eigenvalues[i] = A[order[i]*n+order[i]];
+
+    if( eigenvectors )
+    {
+      eigenvectors->resize( n*n );
+      for( std::size_t k = 0; k < n; ++k )
+        for( std::size_t i = 0; i < n; ++i )
+          (*eigenvectors)[k*n+i] = V[k*n+order[i]];
+    }
+
+    return eigenvalues;
+  }
+}
+
+#endif // DUNE_SYMMETRIC_EIGENVALUE_PROBLEM_HH
@@ -1,7 +1,10 @@
 #ifndef DUNE_TCG_SOLVER_HH
 #define DUNE_TCG_SOLVER_HH
 
+#include <cassert>
+#include <cmath>
 #include <iostream>
+#include <limits>
 #include <utility>
 
 #include <dune/common/typetraits.hh>
@@ -16,6 +19,21 @@ namespace Dune
 {
   namespace TCGSpec
   {
+    //! Trust region radius and results of the last solve, persistent across solves.
+    template <class real_type>
+    struct TrustRegion
+    {
+      bool active() const
+      {
+        return radius < std::numeric_limits<real_type>::max();
+      }
+
+      real_type radius = std::numeric_limits<real_type>::max();
+      /// \f$\|x-x_0\|_{P^{-1}}^2\f$
+      real_type correctionNorm2 = 0;
+      bool boundaryReached = false;
+    };
+
     //! Cache object for the truncated conjugate gradient method.
     template <class Domain, class Range>
     struct Cache : CGSpec::Cache<Domain,Range>
@@ -31,11 +49,21 @@ namespace Dune
       {
         CGSpec::Cache<Domain,Range>::reset(A,P,sp);
         doTerminate = false;
+        correctionNorm2 = correctionPdx = dxNorm2 = 0;
+        if( trustRegion )
+        {
+          trustRegion->correctionNorm2 = 0;
+          trustRegion->boundaryReached = false;
+        }
       }
 
       OperatorType operatorType = OperatorType::PositiveDefinite;
       bool doTerminate = false;
       bool performBlindUpdate = true;
+
+      TrustRegion< real_t<Domain> >* trustRegion = nullptr;
+      /// \f$\|x-x_0\|_{P^{-1}}^2\f$, \f$(x-x_0,P^{-1}\delta x)\f$ and \f$\|\delta x\|_{P^{-1}}^2\f$
+      real_t<Domain> correctionNorm2 = 0, correctionPdx = 0, dxNorm2 = 0;
     };
 
     /*! @cond */
@@ -49,9 +77,14 @@ namespace Dune
     };
     /*! @endcond */
 
-    //! Extends public interface of GenericStep for the truncated conjugate gradient method.
+    /**
+     * @brief Public interface of GenericStep for truncation at directions of non-positive curvature.
+     *
+     * Shared by the truncated and the regularized conjugate gradient methods. Does not provide the trust region, which is only
+     * respected by TCGSpec::Scaling (see InterfaceImpl).
+     */
     template <class Cache, class Name>
-    class InterfaceImpl : public CGSpec::InterfaceImpl<Cache,Name>
+    class TruncationInterfaceImpl : public CGSpec::InterfaceImpl<Cache,Name>
     {
     public:
       bool terminate() const
@@ -74,10 +107,94 @@ namespace Dune
     };
 
 
+    //! Extends public interface of GenericStep for the truncated conjugate gradient method.
+    template <class Cache, class Name>
+    class InterfaceImpl : public TruncationInterfaceImpl<Cache,Name>
+    {
+      using real_type = typename Cache::real_type;
+
+    public:
+      void setCache(Cache* cache)
+      {
+        TruncationInterfaceImpl<Cache,Name>::setCache(cache);
+        cache_->trustRegion = &trustRegion_;
+      }
+
+      /**
+       * @brief Restrict the correction \f$x-x_0\f$ to a trust region (Steihaug-Toint truncated conjugate gradients, see @cite Steihaug1983, @cite Conn2000).
+       *
+       * The iteration terminates as soon as an iterate would leave the trust region \f$\|x-x_0\|_{P^{-1}}\le\Delta\f$, or if a direction of
+       * non-positive curvature is encountered. In both cases the last step ends on the boundary of the trust region. The norm is the one
+       * induced by the preconditioner, i.e. the Euclidean norm for the trivial preconditioner. It is updated from quantities that are computed
+       * anyway, without additional scalar products.
+       *
+       * @param radius trust region radius \f$\Delta\f$
+       */
+      void setTrustRegionRadius(real_type radius)
+      {
+        assert( radius > 0 );
+        trustRegion_.radius = radius;
+      }
+
+      //! Do not restrict the correction to a trust region (default).
+      void disableTrustRegion()
+      {
+        trustRegion_.radius = std::numeric_limits<real_type>::max();
+      }
+
+      //! Check if the last solve terminated on the boundary of the trust region.
+      bool trustRegionBoundaryReached() const
+      {
+        return trustRegion_.boundaryReached;
+      }
+
+      //! Access the norm \f$\|x-x_0\|_{P^{-1}}\f$ of the correction, induced by the preconditioner.
+      real_type correctionNorm() const
+      {
+        using std::sqrt;
+        return sqrt( trustRegion_.correctionNorm2 );
+      }
+
+    protected:
+      using TruncationInterfaceImpl<Cache,Name>::cache_;
+
+    private:
+      TrustRegion<real_type> trustRegion_ = {};
+    };
+
+
     //! Bind second template argument of TCG::InterfaceImpl to satisfy the interface of GenericStep.
     template < class Domain, class Range >
     using Interface = InterfaceImpl< Cache<Domain,Range>, Name >;
 
+    /**
+     * @brief Compute search direction for the conjugate gradient method.
+     *
+     * Additionally updates \f$(x-x_0,P^{-1}\delta x)\f$ and \f$\|\delta x\|_{P^{-1}}^2\f$, using \f$P^{-1}\delta x_{k+1} = r_{k+1} + \beta_k P^{-1}\delta x_k\f$ and
+     * \f$(x_{k+1}-x_0,r_{k+1})=0\f$ (see @cite Conn2000, Section 7.5).
+     */
+    class SearchDirection : public CGSpec::SearchDirection
+    {
+    public:
+      template < class Cache >
+      void operator()( Cache& cache ) const
+      {
+        auto firstStep = cache.firstStep;
+        CGSpec::SearchDirection::operator()( cache );
+
+        if( firstStep )
+        {
+          cache.correctionPdx = 0;
+          cache.dxNorm2 = cache.sigma;
+          return;
+        }
+
+        cache.correctionPdx = cache.beta * ( cache.correctionPdx + cache.alpha * cache.dxNorm2 );
+        cache.dxNorm2 = cache.sigma + cache.beta * cache.beta * cache.dxNorm2;
+      }
+    };
+
+
     //! Compute scaling of the search direction for the conjugate gradient method.
     struct Scaling : Mixin::Verbosity
     {
@@ -87,6 +204,24 @@ namespace Dune
         if( cache.dxAdx > 0 )
         {
           cache.alpha = cache.sigma/cache.dxAdx;
+          if( cache.trustRegion && cache.trustRegion->active() &&
+              correctionNorm2( cache, cache.alpha ) >= cache.trustRegion->radius * cache.trustRegion->radius )
+          {
+            if( verbosityLevel() > 1 )
+              std::cout << "    " << "Truncating at trust region boundary" << std::endl;
+            stepToBoundary( cache );
+            return;
+          }
+          updateCorrectionNorm( cache, correctionNorm2( cache, cache.alpha ) );
+          return;
+        }
+
+        if( cache.trustRegion && cache.trustRegion->active() )
+        {
+          if( verbosityLevel() > 1 )
+            std::cout << "    " << "Truncating at nonconvexity, step to trust region boundary" << std::endl;
+          cache.operatorType = OperatorType::Indefinite;
+          stepToBoundary( cache );
           return;
         }
 
@@ -101,6 +236,36 @@ namespace Dune
         cache.doTerminate = true;
         cache.operatorType = OperatorType::Indefinite;
       }
+
+    private:
+      /// Squared norm of the correction after a step of length alpha.
+      template < class Cache >
+      static typename Cache::real_type correctionNorm2( const Cache& cache, typename Cache::real_type alpha )
+      {
+        return cache.correctionNorm2 + alpha * ( 2 * cache.correctionPdx + alpha * cache.dxNorm2 );
+      }
+
+      template < class Cache >
+      static void updateCorrectionNorm( Cache& cache, typename Cache::real_type correctionNorm2 )
+      {
+        cache.correctionNorm2 = correctionNorm2;
+        if( cache.trustRegion )
+          cache.trustRegion->correctionNorm2 = correctionNorm2;
+      }
+
+      /// Choose the positive scaling alpha with \f$\|x-x_0+\alpha\delta x\|_{P^{-1}}=\Delta\f$ and terminate.
+      template < class Cache >
+      static void stepToBoundary( Cache& cache )
+      {
+        using std::max;
+        using std::sqrt;
+        auto radius2 = cache.trustRegion->radius * cache.trustRegion->radius;
+        auto discriminant = cache.correctionPdx * cache.correctionPdx + cache.dxNorm2 * max( radius2 - cache.correctionNorm2, typename Cache::real_type(0) );
+        cache.alpha = ( sqrt( discriminant ) - cache.correctionPdx ) / cache.dxNorm2;
+        updateCorrectionNorm( cache, radius2 );
+        cache.trustRegion->boundaryReached = true;
+        cache.doTerminate = true;
+      }
     };
 
 
@@ -109,7 +274,7 @@ namespace Dune
     using Step =
     GenericStep<Domain, Range,
       CGSpec::ApplyPreconditioner,
-      CGSpec::SearchDirection,
+      SearchDirection,
       Scaling,
       CGSpec::UpdateIterate,
       Interface<Domain,Range>
@@ -125,6 +290,7 @@ namespace Dune
     form \f$ \frac{1}{2}x^T Ax - b^T x \f$, where \f$A:\ X\mapsto Y\f$ is a possibly indefinite linear operator.
 
     Terminates if a conjugate search direction \f$\delta x\f$ of non-positive curvature is encountered, i.e. if \f$\delta xA\delta x\le 0\f$.
+    Optionally, the correction is restricted to a trust region (see TCGSpec::InterfaceImpl::setTrustRegionRadius()).
 
     @tparam Domain domain space \f$X\f$
     @tparam Range range space \f$Y\f$
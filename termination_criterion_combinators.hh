@@ -0,0 +1,500 @@
+#ifndef DUNE_TERMINATION_CRITERION_COMBINATORS_HH
+#define DUNE_TERMINATION_CRITERION_COMBINATORS_HH
+
+#include <array>
+#include <cassert>
+#include <chrono>
+#include <cstddef>
+#include <limits>
+#include <tuple>
+#include <utility>
+
+#include <dune/common/typetraits.hh>
+
+#include "mixins.hh"
+#include "optional.hh"
+
+namespace Dune
+{
+  /*! @cond */
+  class InverseOperatorResult;
+  /*! @endcond */
+
+  namespace KrylovTerminationCriterion
+  {
+    /*!
+      @ingroup ISTL_Solvers
+      @brief Terminates after a given number of iterations, i.e. independently of GenericIterativeMethod::maxSteps().
+
+      Intended to be combined with other termination criteria (see Any). If it triggers termination, budgetExhausted() returns true and
+      GenericIterativeMethod reports SolverStatus::BudgetExhausted.
+     */
+    template <class real_type>
+    class IterationBudget
+    {
+    public:
+      /*!
+        @brief Constructor.
+        @param iterations maximal number of iterations
+       */
+      explicit IterationBudget(unsigned iterations)
+        : budget_(iterations)
+      {}
+
+      //! @copydoc ResidualBased::init()
+      void init()
+      {
+        iteration_ = 0;
+        exhausted_ = false;
+      }
+
+      //! Nothing to connect, the step implementation is never queried.
+      template <class Step>
+      void connect(Step&&)
+      {}
+
+      //! Nothing to print, use in combination with another termination criterion.
+      void print(InverseOperatorResult&) const
+      {}
+
+      //! @return true if the budget is exhausted
+      operator bool()
+      {
+        exhausted_ = ++iteration_ >= budget_;
+        return exhausted_;
+      }
+
+      //! No error estimate is computed, returns NaN.
+      real_type errorEstimate() const
+      {
+        return std::numeric_limits<real_type>::quiet_NaN();
+      }
+
+      //! @return true if the last iteration has been terminated due to the exhausted budget
+      bool budgetExhausted() const
+      {
+        return exhausted_;
+      }
+
+    private:
+      unsigned budget_, iteration_ = 0;
+      bool exhausted_ = false;
+    };
+
+
+    /*!
+      @ingroup ISTL_Solvers
+      @brief Terminates if the wall-clock time since init() exceeds a given budget.
+
+      The monotonic clock std::chrono::steady_clock is only read every k-th iteration, to keep the overhead negligible for cheap iterations.
+      Intended to be combined with other termination criteria (see Any). If it triggers termination, budgetExhausted() returns true and
+      GenericIterativeMethod reports SolverStatus::BudgetExhausted.
+     */
+    template <class real_type>
+    class WallClockBudget
+    {
+    public:
+      using clock = std::chrono::steady_clock;
+
+      /*!
+        @brief Constructor.
+        @param budget time budget
+        @param checkInterval read the clock every checkInterval iterations
+       */
+      explicit WallClockBudget(clock::duration budget, unsigned checkInterval = 1)
+        : budget_(budget), checkInterval_(checkInterval)
+      {
+        assert( checkInterval_ > 0 );
+      }
+
+      //! @copydoc ResidualBased::init()
+      void init()
+      {
+        iteration_ = 0;
+        exhausted_ = false;
+        start_ = clock::now();
+      }
+
+      //! Nothing to connect, the step implementation is never queried.
+      template <class Step>
+      void connect(Step&&)
+      {}
+
+      //! Nothing to print, use in combination with another termination criterion.
+      void print(InverseOperatorResult&) const
+      {}
+
+      //! @return true if the budget is exhausted
+      operator bool()
+      {
+        if( ++iteration_ % checkInterval_ == 0 )
+          exhausted_ = clock::now() - start_ >= budget_;
+        return exhausted_;
+      }
+
+      //! No error estimate is computed, returns NaN.
+      real_type errorEstimate() const
+      {
+        return std::numeric_limits<real_type>::quiet_NaN();
+      }
+
+      //! @return true if the last iteration has been terminated due to the exhausted budget
+      bool budgetExhausted() const
+      {
+        return exhausted_;
+      }
+
+    private:
+      clock::duration budget_;
+      clock::time_point start_ = {};
+      unsigned checkInterval_, iteration_ = 0;
+      bool exhausted_ = false;
+    };
+
+
+    //! @cond
+    namespace Detail
+    {
+      template <std::size_t i, std::size_t n>
+      struct ForEach
+      {
+        template <class Tuple, class Functor>
+        static void apply(Tuple& criteria, Functor& f)
+        {
+          f( std::get<i>(criteria), i );
+          ForEach<i+1,n>::apply(criteria,f);
+        }
+      };
+
+      template <std::size_t n>
+      struct ForEach<n,n>
+      {
+        template <class Tuple, class Functor>
+        static void apply(Tuple&, Functor&)
+        {}
+      };
+
+      struct Init
+      {
+        template <class Criterion>
+        void operator()(Criterion& criterion, std::size_t) const
+        {
+          criterion.init();
+        }
+      };
+
+      template <class Step>
+      struct Connect
+      {
+        template <class Criterion>
+        void operator()(Criterion& criterion, std::size_t) const
+        {
+          criterion.connect(step);
+        }
+
+        Step& step;
+      };
+
+      template <class Composite>
+      struct AttachMixins
+      {
+        template <class Criterion>
+        void operator()(Criterion& criterion, std::size_t) const
+        {
+          using namespace Mixin;
+          Optional::Mixin::Attach< DUNE_ISTL_MIXINS( typename Composite::real_type ) >::apply( composite, criterion );
+        }
+
+        Composite& composite;
+      };
+
+      template <std::size_t n>
+      struct Evaluate
+      {
+        template <class Criterion>
+        void operator()(Criterion& criterion, std::size_t i)
+        {
+          terminate[i] = static_cast<bool>( criterion );
+          exhausted[i] = Optional::budgetExhausted( criterion );
+          stagnated = stagnated || Optional::stagnated( criterion );
+        }
+
+        std::array<bool,n>& terminate;
+        std::array<bool,n>& exhausted;
+        bool& stagnated;
+      };
+
+      /// Print in reverse order, such that the first criterion determines the result.
+      template <class Tuple, std::size_t i = std::tuple_size<Tuple>::value>
+      struct PrintReverse
+      {
+        static void apply(Tuple& criteria, InverseOperatorResult& res)
+        {
+          std::get<i-1>(criteria).print(res);
+          PrintReverse<Tuple,i-1>::apply(criteria,res);
+        }
+      };
+
+      template <class Tuple>
+      struct PrintReverse<Tuple,0>
+      {
+        static void apply(Tuple&, InverseOperatorResult&)
+        {}
+      };
+
+      struct AllOf
+      {
+        template <std::size_t n>
+        static bool terminate(const std::array<bool,n>& terminate, const std::array<bool,n>&)
+        {
+          for( auto t : terminate )
+            if( !t ) return false;
+          return true;
+        }
+
+        template <std::size_t n>
+        static bool budgetExhausted(const std::array<bool,n>&, const std::array<bool,n>& exhausted)
+        {
+          for( auto e : exhausted )
+            if( e ) return true;
+          return false;
+        }
+      };
+
+      struct AnyOf
+      {
+        template <std::size_t n>
+        static bool terminate(const std::array<bool,n>& terminate, const std::array<bool,n>&)
+        {
+          for( auto t : terminate )
+            if( t ) return true;
+          return false;
+        }
+
+        /// Only report an exhausted budget if no other criterion is satisfied.
+        template <std::size_t n>
+        static bool budgetExhausted(const std::array<bool,n>& terminate, const std::array<bool,n>& exhausted)
+        {
+          auto result = false;
+          for( std::size_t i = 0; i < n; ++i )
+          {
+            if( terminate[i] && !exhausted[i] ) return false;
+            result = result || exhausted[i];
+          }
+          return result;
+        }
+      };
+
+      template <class... Criteria>
+      struct FirstRealType;
+
+      template <class Criterion, class... Criteria>
+      struct FirstRealType<Criterion,Criteria...>
+      {
+        using type = real_t< decltype( std::declval<Criterion>().errorEstimate() ) >;
+      };
+
+      /// Floating point type of the error estimate of the first criterion.
+      template <class... Criteria>
+      using RealOf = typename FirstRealType<Criteria...>::type;
+
+      /**
+       * @brief Combination of termination criteria, without virtual function calls.
+       *
+       * All criteria are evaluated in each iteration, since criteria such as RelativeEnergyError accumulate information in operator bool().
+       * The first criterion is the primary one: its error estimate is reported by errorEstimate(), and its output of print() takes precedence.
+       * Parameters that are set via the mixins, i.e. with GenericIterativeMethod::setRelativeAccuracy(), are forwarded to all criteria.
+       */
+      template <class Combine, class... Criteria>
+      class Composite :
+          public Mixin::AbsoluteAccuracy< RealOf<Criteria...> >,
+          public Mixin::MinimalAccuracy< RealOf<Criteria...> >,
+          public Mixin::RelativeAccuracy< RealOf<Criteria...> >,
+          public Mixin::Verbosity,
+          public Mixin::Eps< RealOf<Criteria...> >,
+          public Mixin::IterativeRefinements,
+          public Mixin::MaxSteps
+      {
+        static constexpr std::size_t n = sizeof...(Criteria);
+
+      public:
+        using real_type = RealOf<Criteria...>;
+
+        //! Constructor. Requires default-constructible criteria.
+        Composite()
+          : criteria_()
+        {
+          attachMixins();
+        }
+
+        //! Constructor.
+        explicit Composite(Criteria... criteria)
+          : criteria_( std::move(criteria)... )
+        {
+          attachMixins();
+        }
+
+        // parameters are copied, observers are connected to the new criteria
+        Composite(const Composite& other)
+          : Mixin::AbsoluteAccuracy<real_type>( other ), Mixin::MinimalAccuracy<real_type>( other ),
+            Mixin::RelativeAccuracy<real_type>( other ), Mixin::Verbosity( other ), Mixin::Eps<real_type>( other ),
+            Mixin::IterativeRefinements( other ), Mixin::MaxSteps( other ),
+            criteria_( other.criteria_ )
+        {
+          attachMixins();
+        }
+
+        Composite(Composite&& other)
+          : Mixin::AbsoluteAccuracy<real_type>( other ), Mixin::MinimalAccuracy<real_type>( other ),
+            Mixin::RelativeAccuracy<real_type>( other ), Mixin::Verbosity( other ), Mixin::Eps<real_type>( other ),
+            Mixin::IterativeRefinements( other ), Mixin::MaxSteps( other ),
+            criteria_( std::move(other.criteria_) )
+        {
+          attachMixins();
+        }
+
+        // parameters are copied, observers remain connected to the criteria of this object
+        Composite& operator=(const Composite& other)
+        {
+          assignMixins( other );
+          criteria_ = other.criteria_;
+          terminate_ = other.terminate_;
+          exhausted_ = other.exhausted_;
+          stagnated_ = other.stagnated_;
+          attachMixins();
+          return *this;
+        }
+
+        Composite& operator=(Composite&& other)
+        {
+          assignMixins( other );
+          criteria_ = std::move(other.criteria_);
+          terminate_ = other.terminate_;
+          exhausted_ = other.exhausted_;
+          stagnated_ = other.stagnated_;
+          attachMixins();
+          return *this;
+        }
+
+        //! @copydoc ResidualBased::init()
+        void init()
+        {
+          Init f;
+          ForEach<0,n>::apply(criteria_,f);
+          terminate_.fill(false);
+          exhausted_.fill(false);
+          stagnated_ = false;
+        }
+
+        //! Connect all criteria to the step implementation.
+        template <class Step>
+        void connect(Step&& step)
+        {
+          Connect< typename std::remove_reference<Step>::type > f{ step };
+          ForEach<0,n>::apply(criteria_,f);
+        }
+
+        //! Evaluate all criteria and combine the results.
+        operator bool()
+        {
+          stagnated_ = false;
+          Evaluate<n> f{ terminate_, exhausted_, stagnated_ };
+          ForEach<0,n>::apply(criteria_,f);
+          return Combine::terminate(terminate_,exhausted_);
+        }
+
+        //! @copydoc ResidualBased::print()
+        void print(InverseOperatorResult& res)
+        {
+          PrintReverse< std::tuple<Criteria...> >::apply(criteria_,res);
+        }
+
+        //! Error estimate of the first criterion.
+        real_type errorEstimate() const
+        {
+          return std::get<0>(criteria_).errorEstimate();
+        }
+
+        //! @return true if the last iteration has been terminated due to an exhausted budget (see IterationBudget, WallClockBudget)
+        bool budgetExhausted() const
+        {
+          return Combine::budgetExhausted(terminate_,exhausted_);
+        }
+
+        //! @return true if one of the criteria detected stagnation (see Stagnation)
+        bool stagnated() const
+        {
+          return stagnated_;
+        }
+
+        //! Access i-th criterion.
+        template <std::size_t i>
+        typename std::tuple_element<i,std::tuple<Criteria...> >::type& get()
+        {
+          return std::get<i>(criteria_);
+        }
+
+      private:
+        void assignMixins(const Composite& other)
+        {
+          Mixin::AbsoluteAccuracy<real_type>::operator=( other );
+          Mixin::MinimalAccuracy<real_type>::operator=( other );
+          Mixin::RelativeAccuracy<real_type>::operator=( other );
+          Mixin::Verbosity::operator=( other );
+          Mixin::Eps<real_type>::operator=( other );
+          Mixin::IterativeRefinements::operator=( other );
+          Mixin::MaxSteps::operator=( other );
+        }
+
+        void attachMixins()
+        {
+          AttachMixins<Composite> f{ *this };
+          ForEach<0,n>::apply(criteria_,f);
+        }
+
+        std::tuple<Criteria...> criteria_;
+        std::array<bool,n> terminate_ = {}, exhausted_ = {};
+        bool stagnated_ = false;
+      };
+    }
+    //! @endcond
+
+
+    /*!
+      @ingroup ISTL_Solvers
+      @brief Terminates if all criteria are satisfied.
+
+      @code{.cpp}
+      template <class real_type>
+      using Criterion = KrylovTerminationCriterion::All< ResidualBased<real_type>, RelativeEnergyError<real_type> >;
+      auto cg = MyCGSolver<Domain,Range,Criterion>(A,P,sp,Criterion<double>( ResidualBased<double>(1e-6), RelativeEnergyError<double>(1e-8) ));
+      @endcode
+     */
+    template <class... Criteria>
+    class All : public Detail::Composite< Detail::AllOf, Criteria... >
+    {
+    public:
+      using Detail::Composite< Detail::AllOf, Criteria... >::Composite;
+    };
+
+
+    /*!
+      @ingroup ISTL_Solvers
+      @brief Terminates if any criterion is satisfied.
+
+      @code{.cpp}
+      template <class real_type>
+      using Criterion = KrylovTerminationCriterion::Any< RelativeEnergyError<real_type>, WallClockBudget<real_type> >;
+      auto cg = MyCGSolver<Domain,Range,Criterion>(A,P,sp,Criterion<double>( RelativeEnergyError<double>(1e-8), WallClockBudget<double>(std::chrono::milliseconds(5)) ));
+      @endcode
+     */
+    template <class... Criteria>
+    class Any : public Detail::Composite< Detail::AnyOf, Criteria... >
+    {
+    public:
+      using Detail::Composite< Detail::AnyOf, Criteria... >::Composite;
+    };
+  }
+}
+
+#endif // DUNE_TERMINATION_CRITERION_COMBINATORS_HH
@@ -0,0 +1,95 @@
+#include <gtest/gtest.h>
+
+#include <array>
+
+#include "dune/istl/solvers.hh"
+#include "../batched_cg_solver.hh"
+
+namespace
+{
+  constexpr std::size_t lanes = 4;
+  using Vector = Dune::BatchedCGSpec::BatchVector<double,lanes>;
+  using Operator = Dune::BatchedCGSpec::BatchedMatrixOperator<double,lanes>;
+  using Matrix = std::array< std::array<double,2>, 2 >;
+
+  struct TestBatchedCGSolver_2d : ::testing::Test
+  {
+    TestBatchedCGSolver_2d()
+      : A(2), x(2), b(2)
+    {
+      // lane 0: same operator as Mock::LinearOperator_2d, lane 1: identity,
+      // lane 2: diagonal, lane 3: zero right hand side
+      matrices = { Matrix{ { { { 4., 1. } }, { { 1., 3. } } } },
+                   Matrix{ { { { 1., 0. } }, { { 0., 1. } } } },
+                   Matrix{ { { { 4., 0. } }, { { 0., 1. } } } },
+                   Matrix{ { { { 3., 1. } }, { { 1., 3. } } } } };
+      rightHandSides = { std::array<double,2>{ { 1., 2. } },
+                         std::array<double,2>{ { 1., 2. } },
+                         std::array<double,2>{ { 1., 2. } },
+                         std::array<double,2>{ { 0., 0. } } };
+      for( std::size_t w = 0; w < lanes; ++w )
+      {
+        A.setMatrix(w,matrices[w]);
+        b.setLane(w,rightHandSides[w]);
+      }
+    }
+
+    void checkSolution() const
+    {
+      for( std::size_t w = 0; w < lanes; ++w )
+      {
+        auto xw = std::array<double,2>{};
+        x.getLane(w,xw);
+        for( std::size_t i = 0; i < 2; ++i )
+          EXPECT_NEAR( matrices[w][i][0]*xw[0] + matrices[w][i][1]*xw[1], rightHandSides[w][i], 1e-10 );
+      }
+    }
+
+    Operator A;
+    Vector x, b;
+    std::array<Matrix,lanes> matrices;
+    std::array< std::array<double,2>, lanes > rightHandSides;
+    std::array<Dune::InverseOperatorResult,lanes> res;
+  };
+}
+
+
+TEST_F(TestBatchedCGSolver_2d,MaskedConvergence)
+{
+  auto P = Dune::BatchedCGSpec::BatchedIdentityPreconditioner();
+  auto cg = Dune::BatchedCGSolver<Operator,Dune::BatchedCGSpec::BatchedIdentityPreconditioner>(A,P,1e-12);
+  cg.apply(x,b,res);
+
+  checkSolution();
+  for( auto& r : res )
+    EXPECT_TRUE( r.converged );
+  EXPECT_EQ( res[0].iterations, 2 );
+  EXPECT_EQ( res[1].iterations, 1 );
+  EXPECT_EQ( res[2].iterations, 2 );
+  EXPECT_EQ( res[3].iterations, 0 );
+}
+
+TEST_F(TestBatchedCGSolver_2d,JacobiPreconditioner)
+{
+  auto P = Dune::BatchedCGSpec::BatchedJacobiPreconditioner<double,lanes>(A);
+  auto cg = Dune::BatchedCGSolver<Operator,Dune::BatchedCGSpec::BatchedJacobiPreconditioner<double,lanes> >(A,P,1e-12);
+  cg.apply(x,b,res);
+
+  checkSolution();
+  // diagonal systems are solved exactly in the first step
+  EXPECT_EQ( res[1].iterations, 1 );
+  EXPECT_EQ( res[2].iterations, 1 );
+}
+
+TEST_F(TestBatchedCGSolver_2d,MaxSteps)
+{
+  auto P = Dune::BatchedCGSpec::BatchedIdentityPreconditioner();
+  auto cg = Dune::BatchedCGSolver<Operator,Dune::BatchedCGSpec::BatchedIdentityPreconditioner>(A,P,1e-12);
+  cg.setMaxSteps(1);
+  cg.apply(x,b,res);
+
+  EXPECT_FALSE( res[0].converged );
+  EXPECT_TRUE( res[1].converged );
+  EXPECT_FALSE( res[2].converged );
+  EXPECT_EQ( res[0].iterations, 1 );
+}
@@ -111,3 +111,52 @@ TEST_F(TestCGSolver_2d,TwoSteps)
   ASSERT_DOUBLE_EQ( x.data_[0], 0.0909090909090909 );
   ASSERT_DOUBLE_EQ( x.data_[1], 0.6363636363636364 );
 }
+
+TEST_F(TestCGSolver_2d,LanczosRecording_DisabledByDefault)
+{
+  cg.setMaxSteps(2);
+  auto x = initialGuess();
+  auto b = rightHandSide();
+
+  cg.apply(x,b);
+
+  ASSERT_EQ( cg.getStep().lanczosMatrix().size(), 0u );
+}
+
+TEST_F(TestCGSolver_2d,LanczosRecording_RitzValues)
+{
+  cg.getStep().enableLanczosRecording();
+  cg.setMaxSteps(2);
+  auto x = initialGuess();
+  auto b = rightHandSide();
+
+  cg.apply(x,b);
+
+  // the eigenvalues of the operator are (7-sqrt(5))/2 and (7+sqrt(5))/2
+  ASSERT_EQ( cg.getStep().lanczosMatrix().size(), 2u );
+  EXPECT_NEAR( cg.getStep().smallestRitzValue(), (7-sqrt(5.))/2, 1e-12 );
+  EXPECT_NEAR( cg.getStep().largestRitzValue(), (7+sqrt(5.))/2, 1e-12 );
+  EXPECT_NEAR( cg.getStep().conditionNumberEstimate(), (7+sqrt(5.))/(7-sqrt(5.)), 1e-12 );
+}
+
+TEST_F(TestCGSolver_2d,LanczosRecording_OneStep)
+{
+  cg.getStep().enableLanczosRecording();
+  cg.setMaxSteps(1);
+  auto x = initialGuess();
+  auto b = rightHandSide();
+
+  cg.apply(x,b);
+
+  // the only Ritz value is the Rayleigh quotient of the initial residual
+  ASSERT_EQ( cg.getStep().lanczosMatrix().size(), 1u );
+  EXPECT_NEAR( cg.getStep().smallestRitzValue(), 331./73, 1e-12 );
+  EXPECT_NEAR( cg.getStep().largestRitzValue(), 331./73, 1e-12 );
+
+  // a new solve discards the previous Lanczos matrix
+  cg.setMaxSteps(2);
+  x = initialGuess();
+  b = rightHandSide();
+  cg.apply(x,b);
+  EXPECT_EQ( cg.getStep().lanczosMatrix().size(), 2u );
+}
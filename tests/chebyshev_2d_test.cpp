@@ -0,0 +1,288 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+
+#include <dune/istl/scalarproducts.hh>
+
+#include "mock/linearOperator_2d.hh"
+#include "mock/trivialPreconditioner.hh"
+#include "mock/vector.hh"
+
+#include "../chebyshev_semi_iteration.hh"
+
+/*
+ * Test Chebyshev semi-iteration with the example given at:
+ *
+ *   https://en.wikipedia.org/wiki/Conjugate_gradient_method#Numerical_example
+ *
+ * The eigenvalues of the operator are (7-sqrt(5))/2 and (7+sqrt(5))/2.
+ */
+
+namespace Mock = Dune::Mock;
+using Mock::Vector;
+
+namespace
+{
+  struct ScalarProduct : Dune::ScalarProduct<Vector>
+  {
+    static constexpr int category = Dune::SolverCategory::sequential;
+
+    typename Dune::ScalarProduct<Vector>::field_type dot(const Vector& x, const Vector& y) final override
+    {
+      ++numberOfDotProducts;
+      double result = 0;
+      for ( std::size_t i = 0; i < x.data_.size(); ++i )
+        result += x.data_[i] * y.data_[i];
+      return result;
+    }
+
+   double norm(const Vector& x) final override
+    {
+      return sqrt(dot(x,x));
+    }
+
+    unsigned numberOfDotProducts = 0;
+  };
+
+  struct TestChebyshev_2d : ::testing::Test
+  {
+    TestChebyshev_2d()
+      : A(), P(), sp(),
+        chebyshev( A, P, sp, Dune::KrylovTerminationCriterion::ResidualBased<double>(1e-10) )
+    {
+      chebyshev.getStep().setSpectralBounds( 2, 5 );
+    }
+
+    Dune::Mock::LinearOperator_2d A;
+    Dune::Mock::TrivialPreconditioner P;
+    ScalarProduct sp;
+    Dune::ChebyshevSemiIteration< Vector, Vector > chebyshev;
+  };
+
+  struct CountingLinearOperator_2d : Dune::Mock::LinearOperator_2d
+  {
+    void apply( const Vector& x, Vector& y ) const
+    {
+      ++numberOfApplications;
+      Dune::Mock::LinearOperator_2d::apply( x, y );
+    }
+
+    mutable unsigned numberOfApplications = 0;
+  };
+
+  struct TestChebyshevWithEstimatedBounds_2d : ::testing::Test
+  {
+    TestChebyshevWithEstimatedBounds_2d()
+      : A(), P(), sp(),
+        chebyshev( A, P, sp, Dune::KrylovTerminationCriterion::ResidualBased<double>(1e-10) )
+    {
+      chebyshev.getStep().enableSpectralBoundsEstimation();
+    }
+
+    CountingLinearOperator_2d A;
+    Dune::Mock::TrivialPreconditioner P;
+    ScalarProduct sp;
+    Dune::ChebyshevSemiIteration< Vector, Vector > chebyshev;
+  };
+
+  struct TestFixedStepChebyshev_2d : ::testing::Test
+  {
+    TestFixedStepChebyshev_2d()
+      : A(), P(), sp(),
+        chebyshev( A, P, sp )
+    {
+      chebyshev.getStep().setSpectralBounds( 2, 5 );
+    }
+
+    Dune::Mock::LinearOperator_2d A;
+    Dune::Mock::TrivialPreconditioner P;
+    ScalarProduct sp;
+    Dune::FixedStepChebyshevSemiIteration< Vector, Vector > chebyshev;
+  };
+
+  Vector initialGuess()
+  {
+    return Vector( { 2., 1. } );
+  }
+
+  Vector rightHandSide()
+  {
+    return Vector( { 1., 2. } );
+  }
+
+  inline double testAccuracy()
+  {
+    return 1e-9;
+  }
+}
+
+TEST_F(TestChebyshev_2d,UninitializedSpectralBounds)
+{
+  auto chebyshevWithoutBounds = Dune::ChebyshevSemiIteration< Vector, Vector >( A, P, sp, Dune::KrylovTerminationCriterion::ResidualBased<double>() );
+  auto x = initialGuess();
+  auto b = rightHandSide();
+
+  ASSERT_THROW( chebyshevWithoutBounds.apply(x,b), std::runtime_error );
+}
+
+TEST_F(TestChebyshev_2d,OneStep)
+{
+  chebyshev.setMaxSteps(1);
+  auto x = initialGuess();
+  auto b = rightHandSide();
+
+  chebyshev.apply(x,b);
+
+  // first step is a Richardson step scaled with the inverse spectral center
+  ASSERT_DOUBLE_EQ( x.data_[0], 2 + -8/3.5 );
+  ASSERT_DOUBLE_EQ( x.data_[1], 1 + -3/3.5 );
+}
+
+TEST_F(TestChebyshev_2d,Converged)
+{
+  auto x = initialGuess();
+  auto b = rightHandSide();
+
+  Dune::InverseOperatorResult res;
+  chebyshev.apply(x,b,res);
+
+  EXPECT_TRUE( res.converged );
+  EXPECT_NEAR( x.data_[0], 1./11, testAccuracy() );
+  EXPECT_NEAR( x.data_[1], 7./11, testAccuracy() );
+}
+
+TEST_F(TestChebyshev_2d,RepeatedSolves)
+{
+  auto x = initialGuess();
+  auto b = rightHandSide();
+  chebyshev.apply(x,b);
+
+  x = initialGuess();
+  b = rightHandSide();
+  Dune::InverseOperatorResult res;
+  chebyshev.apply(x,b,res);
+
+  EXPECT_TRUE( res.converged );
+  EXPECT_NEAR( x.data_[0], 1./11, testAccuracy() );
+  EXPECT_NEAR( x.data_[1], 7./11, testAccuracy() );
+}
+
+TEST_F(TestChebyshev_2d,DivergesForWrongSpectralBounds)
+{
+  chebyshev.getStep().setSpectralBounds( 1, 2 );
+  chebyshev.setMaxSteps(100);
+  auto x = initialGuess();
+  auto b = rightHandSide();
+
+  Dune::InverseOperatorResult res;
+  chebyshev.apply(x,b,res);
+
+  EXPECT_FALSE( res.converged );
+}
+
+TEST_F(TestChebyshev_2d,AdaptiveSpectralBounds_UpperBoundTooSmall)
+{
+  chebyshev.getStep().setSpectralBounds( 1, 2 );
+  chebyshev.getStep().enableAdaptiveSpectralBounds();
+  chebyshev.setMaxSteps(100);
+  auto x = initialGuess();
+  auto b = rightHandSide();
+
+  Dune::InverseOperatorResult res;
+  chebyshev.apply(x,b,res);
+
+  EXPECT_TRUE( res.converged );
+  EXPECT_NEAR( x.data_[0], 1./11, testAccuracy() );
+  EXPECT_NEAR( x.data_[1], 7./11, testAccuracy() );
+}
+
+TEST_F(TestChebyshev_2d,AdaptiveSpectralBounds_LowerBoundTooLarge)
+{
+  chebyshev.getStep().setSpectralBounds( 4, 5 );
+  chebyshev.getStep().enableAdaptiveSpectralBounds();
+  chebyshev.setMaxSteps(100);
+  auto x = initialGuess();
+  auto b = rightHandSide();
+
+  Dune::InverseOperatorResult res;
+  chebyshev.apply(x,b,res);
+
+  EXPECT_TRUE( res.converged );
+  EXPECT_NEAR( x.data_[0], 1./11, testAccuracy() );
+  EXPECT_NEAR( x.data_[1], 7./11, testAccuracy() );
+}
+
+TEST_F(TestChebyshevWithEstimatedBounds_2d,Converged)
+{
+  auto x = initialGuess();
+  auto b = rightHandSide();
+
+  Dune::InverseOperatorResult res;
+  chebyshev.apply(x,b,res);
+
+  EXPECT_TRUE( res.converged );
+  EXPECT_NEAR( x.data_[0], 1./11, testAccuracy() );
+  EXPECT_NEAR( x.data_[1], 7./11, testAccuracy() );
+}
+
+TEST_F(TestChebyshevWithEstimatedBounds_2d,ReuseEstimatedBounds)
+{
+  auto x = initialGuess();
+  auto b = rightHandSide();
+  chebyshev.apply(x,b);
+  auto numberOfApplications = A.numberOfApplications;
+  EXPECT_GT( numberOfApplications, 0u );
+
+  x = initialGuess();
+  b = rightHandSide();
+  Dune::InverseOperatorResult res;
+  chebyshev.apply(x,b,res);
+
+  EXPECT_EQ( A.numberOfApplications, numberOfApplications );
+  EXPECT_TRUE( res.converged );
+  EXPECT_NEAR( x.data_[0], 1./11, testAccuracy() );
+  EXPECT_NEAR( x.data_[1], 7./11, testAccuracy() );
+}
+
+TEST_F(TestChebyshevWithEstimatedBounds_2d,VanishingResidual)
+{
+  auto x = Vector( { 0., 0. } );
+  auto b = Vector( { 0., 0. } );
+
+  chebyshev.setMaxSteps(2);
+  EXPECT_NO_THROW( chebyshev.apply(x,b) );
+  EXPECT_DOUBLE_EQ( x.data_[0], 0 );
+  EXPECT_DOUBLE_EQ( x.data_[1], 0 );
+}
+
+TEST_F(TestFixedStepChebyshev_2d,NoInnerProducts)
+{
+  chebyshev.setMaxSteps(3);
+  auto x = initialGuess();
+  auto b = rightHandSide();
+
+  Dune::InverseOperatorResult res;
+  chebyshev.apply(x,b,res);
+
+  EXPECT_TRUE( res.converged );
+  EXPECT_EQ( res.iterations, 3 );
+  EXPECT_EQ( sp.numberOfDotProducts, 0u );
+}
+
+TEST_F(TestFixedStepChebyshev_2d,SameIteratesAsChebyshevSemiIteration)
+{
+  Dune::ChebyshevSemiIteration< Vector, Vector > referenceChebyshev( A, P, sp, Dune::KrylovTerminationCriterion::ResidualBased<double>(0) );
+  referenceChebyshev.getStep().setSpectralBounds( 2, 5 );
+  referenceChebyshev.setMaxSteps(3);
+  auto x0 = initialGuess();
+  auto b0 = rightHandSide();
+  referenceChebyshev.apply(x0,b0);
+
+  chebyshev.setMaxSteps(3);
+  auto x = initialGuess();
+  auto b = rightHandSide();
+  chebyshev.apply(x,b);
+
+  EXPECT_DOUBLE_EQ( x.data_[0], x0.data_[0] );
+  EXPECT_DOUBLE_EQ( x.data_[1], x0.data_[1] );
+}
@@ -0,0 +1,111 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+
+#include <dune/istl/scalarproducts.hh>
+
+#include "mock/linearOperator_2d.hh"
+#include "mock/trivialPreconditioner.hh"
+#include "mock/vector.hh"
+
+#include "../cg_solver.hh"
+#include "../chebyshev_preconditioner.hh"
+#include "../residual_based_termination_criterion.hh"
+
+namespace Mock = Dune::Mock;
+using Mock::Vector;
+
+namespace
+{
+  struct ScalarProduct : Dune::ScalarProduct<Vector>
+  {
+    static constexpr int category = Dune::SolverCategory::sequential;
+
+    typename Dune::ScalarProduct<Vector>::field_type dot(const Vector& x, const Vector& y) final override
+    {
+      ++numberOfDotProducts;
+      double result = 0;
+      for ( std::size_t i = 0; i < x.data_.size(); ++i )
+        result += x.data_[i] * y.data_[i];
+      return result;
+    }
+
+   double norm(const Vector& x) final override
+    {
+      return sqrt(dot(x,x));
+    }
+
+    unsigned numberOfDotProducts = 0;
+  };
+
+  struct TestChebyshevPreconditioner_2d : ::testing::Test
+  {
+    TestChebyshevPreconditioner_2d()
+      : A(), P(), sp(),
+        chebyshev( A, P, sp, 3 )
+    {
+      chebyshev.getStep().setSpectralBounds( 2, 5 );
+    }
+
+    Dune::Mock::LinearOperator_2d A;
+    Dune::Mock::TrivialPreconditioner P;
+    ScalarProduct sp;
+    Dune::ChebyshevPreconditioner< Vector, Vector > chebyshev;
+  };
+
+  Vector rightHandSide()
+  {
+    return Vector( { 1., 2. } );
+  }
+
+  inline double testAccuracy()
+  {
+    return 1e-9;
+  }
+}
+
+TEST_F(TestChebyshevPreconditioner_2d,SameAsFixedStepChebyshevSemiIteration)
+{
+  Dune::FixedStepChebyshevSemiIteration< Vector, Vector > referenceChebyshev( A, P, sp );
+  referenceChebyshev.getStep().setSpectralBounds( 2, 5 );
+  referenceChebyshev.setMaxSteps( chebyshev.degree() );
+  auto x0 = Vector( { 0., 0. } );
+  auto b0 = rightHandSide();
+  referenceChebyshev.apply(x0,b0);
+
+  auto x = Vector( { 1., 1. } );
+  const auto b = rightHandSide();
+  chebyshev.apply(x,b);
+
+  EXPECT_DOUBLE_EQ( x.data_[0], x0.data_[0] );
+  EXPECT_DOUBLE_EQ( x.data_[1], x0.data_[1] );
+  EXPECT_EQ( sp.numberOfDotProducts, 0u );
+}
+
+TEST_F(TestChebyshevPreconditioner_2d,RepeatedApplication)
+{
+  auto x0 = Vector( { 0., 0. } );
+  const auto b = rightHandSide();
+  chebyshev.apply(x0,b);
+
+  auto x = Vector( { 0., 0. } );
+  chebyshev.apply(x,b);
+
+  EXPECT_DOUBLE_EQ( x.data_[0], x0.data_[0] );
+  EXPECT_DOUBLE_EQ( x.data_[1], x0.data_[1] );
+}
+
+TEST_F(TestChebyshevPreconditioner_2d,PolynomialPreconditionedCG)
+{
+  Dune::MyCGSolver< Vector, Vector , Dune::KrylovTerminationCriterion::ResidualBased > cg( A, chebyshev, sp );
+  cg.setRelativeAccuracy( 1e-12 );
+  auto x = Vector( { 2., 1. } );
+  auto b = rightHandSide();
+
+  Dune::InverseOperatorResult res;
+  cg.apply(x,b,res);
+
+  EXPECT_TRUE( res.converged );
+  EXPECT_NEAR( x.data_[0], 1./11, testAccuracy() );
+  EXPECT_NEAR( x.data_[1], 7./11, testAccuracy() );
+}
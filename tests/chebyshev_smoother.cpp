@@ -0,0 +1,120 @@
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <type_traits>
+
+#include <dune/common/fmatrix.hh>
+#include <dune/common/fvector.hh>
+#include <dune/istl/bcrsmatrix.hh>
+#include <dune/istl/bvector.hh>
+
+#include "../chebyshev_smoother.hh"
+
+/*
+ * Test ChebyshevSmoother, constructed as in algebraic multigrid, for the tridiagonal matrix tridiag(-1,4,-1).
+ * The spectrum of the Jacobi-preconditioned matrix is contained in (0.5,1.5).
+ */
+
+namespace
+{
+  const std::size_t n = 50;
+
+  using Matrix = Dune::BCRSMatrix< Dune::FieldMatrix<double,1,1> >;
+  using Vector = Dune::BlockVector< Dune::FieldVector<double,1> >;
+  using Smoother = Dune::ChebyshevSmoother<Matrix,Vector>;
+
+  Matrix tridiagonalMatrix()
+  {
+    Matrix A( n, n, Matrix::random );
+    for( std::size_t i = 0; i < n; ++i )
+      A.setrowsize( i, ( i == 0 || i+1 == n ) ? 2 : 3 );
+    A.endrowsizes();
+    for( std::size_t i = 0; i < n; ++i )
+    {
+      A.addindex( i, i );
+      if( i > 0 )
+        A.addindex( i, i-1 );
+      if( i+1 < n )
+        A.addindex( i, i+1 );
+    }
+    A.endindices();
+
+    for( std::size_t i = 0; i < n; ++i )
+    {
+      A[i][i] = 4;
+      if( i > 0 )
+        A[i][i-1] = -1;
+      if( i+1 < n )
+        A[i][i+1] = -1;
+    }
+    return A;
+  }
+
+  Vector defect()
+  {
+    Vector d( n );
+    for( std::size_t i = 0; i < n; ++i )
+      d[i] = 1 + ( i%7 ) - 0.5 * ( i%3 );
+    return d;
+  }
+
+  struct TestChebyshevSmoother : ::testing::Test
+  {
+    TestChebyshevSmoother()
+      : A( tridiagonalMatrix() )
+    {
+      smootherArgs.iterations = 4;
+      Dune::Amg::ConstructionTraits<Smoother>::Arguments args;
+      args.setMatrix( A );
+      args.setArgs( smootherArgs );
+      smoother = Dune::Amg::ConstructionTraits<Smoother>::construct( args );
+    }
+
+    ~TestChebyshevSmoother()
+    {
+      Dune::Amg::ConstructionTraits<Smoother>::deconstruct( smoother );
+    }
+
+    /// @return \f$\|d-Av\|/\|d\|\f$ after one application of the smoother to \f$d\f$
+    double residualReduction()
+    {
+      auto d = defect();
+      Vector v( n );
+      v = 0;
+      smoother->pre( v, d );
+      smoother->apply( v, d );
+      smoother->post( v );
+
+      auto r = d;
+      A.usmv( -1, v, r );
+      return r.two_norm() / d.two_norm();
+    }
+
+    Matrix A;
+    Dune::Amg::SmootherTraits<Smoother>::Arguments smootherArgs;
+    Smoother* smoother = nullptr;
+  };
+}
+
+TEST_F(TestChebyshevSmoother,NotCopyable)
+{
+  static_assert( !std::is_copy_constructible<Smoother>::value, "ChebyshevSmoother refers to its own members and must not be copied" );
+  static_assert( !std::is_copy_assignable<Smoother>::value, "ChebyshevSmoother refers to its own members and must not be copied" );
+  EXPECT_EQ( smoother->getPreconditioner().degree(), 4u );
+}
+
+TEST_F(TestChebyshevSmoother,ReductionForExactSpectralBounds)
+{
+  // the Jacobi preconditioner is a multiple of the identity, thus ||r||_P/||r_0||_P = ||r||/||r_0|| <= 1/T_4(2) = 1/97
+  smoother->getPreconditioner().getStep().setSpectralBounds( 0.5, 1.5 );
+  EXPECT_LE( residualReduction(), 1./97 );
+}
+
+TEST_F(TestChebyshevSmoother,ReductionForEstimatedSpectralBounds)
+{
+  // the Ritz values approximate the extreme eigenvalues well and are enlarged by the safety factor, i.e. the reduction is close to 1/97
+  auto first = residualReduction();
+  EXPECT_LT( first, 2./97 );
+  // the estimated bounds are reused
+  EXPECT_DOUBLE_EQ( residualReduction(), first );
+}
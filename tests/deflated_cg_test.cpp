@@ -0,0 +1,257 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <vector>
+
+#include <dune/istl/operators.hh>
+#include <dune/istl/preconditioner.hh>
+#include <dune/istl/scalarproducts.hh>
+
+#include "mock/trivialPreconditioner.hh"
+#include "mock/vector.hh"
+
+#include "../deflated_cg_solver.hh"
+#include "../residual_based_termination_criterion.hh"
+
+/*
+ * Test the deflated conjugate gradient method for a sequence of ill-conditioned diagonal systems,
+ * with a few isolated small eigenvalues and the remaining eigenvalues in [1,2].
+ */
+
+namespace Mock = Dune::Mock;
+using Mock::Vector;
+
+namespace
+{
+  inline double testAccuracy()
+  {
+    return 1e-6;
+  }
+
+  const std::size_t n = 200;
+
+  struct ScalarProduct : Dune::ScalarProduct<Vector>
+  {
+    static constexpr int category = Dune::SolverCategory::sequential;
+
+    typename Dune::ScalarProduct<Vector>::field_type dot(const Vector& x, const Vector& y) final override
+    {
+      return x.dot(y);
+    }
+
+    double norm(const Vector& x) final override
+    {
+      return sqrt(dot(x,x));
+    }
+  };
+
+  struct DiagonalOperator : Dune::LinearOperator<Vector,Vector>
+  {
+    static constexpr int category = Dune::SolverCategory::sequential;
+
+    DiagonalOperator()
+      : diagonal(n)
+    {
+      for( std::size_t i = 0; i < n; ++i )
+        diagonal[i] = ( i < 4 ? 1e-4*(i+1) : 1 + double(i)/n );
+    }
+
+    void apply(const Vector& x, Vector& y) const final override
+    {
+      ++numberOfApplications;
+      for( std::size_t i = 0; i < n; ++i )
+        y[i] = diagonal[i] * x[i];
+    }
+
+    void applyscaleadd(double a, const Vector& x, Vector& y) const final override
+    {
+      for( std::size_t i = 0; i < n; ++i )
+        y[i] += a * diagonal[i] * x[i];
+    }
+
+    std::vector<double> diagonal;
+    mutable unsigned numberOfApplications = 0;
+  };
+
+  // Diagonal preconditioner that does not remove the small eigenvalues.
+  struct DiagonalPreconditioner : Dune::Preconditioner<Vector,Vector>
+  {
+    static constexpr int category = Dune::SolverCategory::sequential;
+
+    void pre(Vector&, Vector&) final override
+    {}
+
+    void apply(Vector& x, const Vector& y) final override
+    {
+      for( std::size_t i = 0; i < n; ++i )
+        x[i] = ( 1 + 0.5 * (i%3) ) * y[i];
+    }
+
+    void post(Vector&) final override
+    {}
+  };
+
+  Vector rightHandSide(double shift)
+  {
+    auto b = Vector( std::vector<double>( n ) );
+    for( std::size_t i = 0; i < n; ++i )
+      b[i] = 1 + shift * sin( double(i) );
+    return b;
+  }
+
+  template <class Preconditioner>
+  struct TestDeflatedCG : ::testing::Test
+  {
+    TestDeflatedCG()
+      : A(), P(), sp(),
+        cg( A, P, sp, Dune::KrylovTerminationCriterion::ResidualBased<double>(1e-10) )
+    {
+      cg.setMaxSteps( 1000 );
+    }
+
+    unsigned solve(double shift)
+    {
+      auto x = Vector( std::vector<double>( n, 0. ) );
+      auto b = rightHandSide( shift );
+      Dune::InverseOperatorResult res;
+      cg.apply( x, b, res );
+
+      auto b0 = rightHandSide( shift );
+      for( std::size_t i = 0; i < n; ++i )
+        EXPECT_NEAR( x[i], b0[i]/A.diagonal[i], testAccuracy() * std::abs( b0[i]/A.diagonal[i] ) );
+      return res.iterations;
+    }
+
+    DiagonalOperator A;
+    Preconditioner P;
+    ScalarProduct sp;
+    Dune::DCGSolver< Vector, Vector, Dune::KrylovTerminationCriterion::ResidualBased > cg;
+  };
+
+  using Preconditioners = ::testing::Types< Dune::Mock::TrivialPreconditioner, DiagonalPreconditioner >;
+}
+
+TYPED_TEST_SUITE(TestDeflatedCG, Preconditioners);
+
+TYPED_TEST(TestDeflatedCG,FirstSolveEqualsCG)
+{
+  auto x = Vector( std::vector<double>( n, 0. ) );
+  auto b = rightHandSide( 0 );
+  Dune::InverseOperatorResult res;
+  auto cg = Dune::MyCGSolver< Vector, Vector, Dune::KrylovTerminationCriterion::ResidualBased >
+      ( this->A, this->P, this->sp, Dune::KrylovTerminationCriterion::ResidualBased<double>(1e-10) );
+  cg.apply( x, b, res );
+
+  EXPECT_EQ( this->cg.getStep().getRecycledSubspace().dimension(), 0u );
+  EXPECT_EQ( this->solve( 0 ), static_cast<unsigned>(res.iterations) );
+  EXPECT_EQ( this->cg.getStep().getRecycledSubspace().dimension(), this->cg.getStep().getRecycledSubspace().maxDimension() );
+}
+
+TYPED_TEST(TestDeflatedCG,RecyclingReducesIterations)
+{
+  auto first = this->solve( 0 );
+  auto second = this->solve( 0.1 );
+  auto third = this->solve( 0.2 );
+  auto fourth = this->solve( 0.3 );
+
+  EXPECT_LT( second, first );
+  EXPECT_LE( third, second );
+  EXPECT_LE( fourth, third );
+  EXPECT_LT( 2*fourth, first );
+}
+
+TYPED_TEST(TestDeflatedCG,RitzValuesApproximateSmallestEigenvalues)
+{
+  for( auto shift : { 0., 0.1, 0.2, 0.3 } )
+    this->solve( shift );
+
+  const auto& ritzValues = this->cg.getStep().getRecycledSubspace().ritzValues();
+  ASSERT_GE( ritzValues.size(), 4u );
+  // the four isolated eigenvalues of PA are found
+  for( auto i = 0u; i < 4u; ++i )
+  {
+    EXPECT_GT( ritzValues[i], 0.9e-4 );
+    EXPECT_LT( ritzValues[i], 1e-3 );
+  }
+  EXPECT_GT( ritzValues[4], 0.5 );
+}
+
+TYPED_TEST(TestDeflatedCG,ChangingOperator)
+{
+  this->solve( 0 );
+  auto first = this->solve( 0.1 );
+
+  for( auto& entry : this->A.diagonal )
+    entry *= 1.05;
+  auto second = this->solve( 0.1 );
+
+  EXPECT_LE( second, first + 2 );
+}
+
+TYPED_TEST(TestDeflatedCG,ClearSubspace)
+{
+  auto first = this->solve( 0 );
+  this->solve( 0 );
+
+  this->cg.getStep().getRecycledSubspace().clear();
+  EXPECT_EQ( this->cg.getStep().getRecycledSubspace().dimension(), 0u );
+  EXPECT_EQ( this->solve( 0 ), first );
+}
+
+TYPED_TEST(TestDeflatedCG,LanczosRecording)
+{
+  this->cg.getStep().enableLanczosRecording();
+  auto first = this->solve( 0 );
+  EXPECT_EQ( this->cg.getStep().lanczosMatrix().size(), first );
+  EXPECT_LT( this->cg.getStep().smallestRitzValue(), 1e-3 );
+
+  // only the steps of the last solve are recorded, the deflated operator has no small eigenvalues
+  for( auto shift : { 0.1, 0.2, 0.3 } )
+    this->solve( shift );
+  auto last = this->solve( 0.4 );
+  EXPECT_EQ( this->cg.getStep().lanczosMatrix().size(), last );
+  EXPECT_GT( this->cg.getStep().smallestRitzValue(), 0.5 );
+}
+
+TEST(DeflatedCG,ChangingPreconditioner)
+{
+  DiagonalOperator A;
+  DiagonalPreconditioner P;
+  Mock::TrivialPreconditioner Q;
+  ScalarProduct sp;
+  auto makeSolver = [&A,&sp]( Dune::Preconditioner<Vector,Vector>& preconditioner )
+  {
+    auto cg = Dune::DCGSolver< Vector, Vector, Dune::KrylovTerminationCriterion::ResidualBased >
+        ( A, preconditioner, sp, Dune::KrylovTerminationCriterion::ResidualBased<double>(1e-10) );
+    cg.setMaxSteps( 1000 );
+    return cg;
+  };
+  auto solve = []( Dune::DCGSolver< Vector, Vector, Dune::KrylovTerminationCriterion::ResidualBased >& cg )
+  {
+    auto x = Vector( std::vector<double>( n, 0. ) );
+    auto b = rightHandSide( 0 );
+    Dune::InverseOperatorResult res;
+    cg.apply( x, b, res );
+    EXPECT_TRUE( res.converged );
+  };
+
+  auto cg = makeSolver( P );
+  solve( cg );
+  solve( cg );
+
+  // the subspace is recycled with a different preconditioner, P^{-1}W is discarded
+  auto other = makeSolver( Q );
+  other.getStep().getRecycledSubspace() = cg.getStep().getRecycledSubspace();
+  solve( other );
+  solve( other );
+  solve( other );
+  solve( other );
+
+  const auto& ritzValues = other.getStep().getRecycledSubspace().ritzValues();
+  ASSERT_GE( ritzValues.size(), 4u );
+  for( auto i = 0u; i < 4u; ++i )
+  {
+    EXPECT_GT( ritzValues[i], 0.9e-4 );
+    EXPECT_LT( ritzValues[i], 1e-3 );
+  }
+}
@@ -0,0 +1,99 @@
+#include <gtest/gtest.h>
+
+#include <dune/common/fmatrix.hh>
+#include <dune/common/fvector.hh>
+
+#include "dune/istl/solvers.hh"
+#include "../fixed_size_cg_solver.hh"
+#include "../relative_energy_termination_criterion.hh"
+
+namespace
+{
+  using Vector = Dune::FieldVector<double,6>;
+  using Matrix = Dune::FieldMatrix<double,6,6>;
+
+  // tridiagonal matrix with diagonal (i+2) and off-diagonal -1
+  Matrix tridiagonalMatrix()
+  {
+    auto A = Matrix(0.);
+    for( int i = 0; i < 6; ++i )
+    {
+      A[i][i] = i+2;
+      if( i > 0 ) A[i][i-1] = A[i-1][i] = -1;
+    }
+    return A;
+  }
+
+  void checkSolution(const Matrix& A, const Vector& x, const Vector& b, double tolerance)
+  {
+    auto Ax = Vector(0.);
+    A.mv(x,Ax);
+    for( int i = 0; i < 6; ++i )
+      EXPECT_NEAR( Ax[i], b[i], tolerance );
+  }
+}
+
+
+TEST(FixedSizeCGSolver,Solve_2d)
+{
+  auto A = Dune::FieldMatrix<double,2,2>{ { 4., 1. }, { 1., 3. } };
+  auto b = Dune::FieldVector<double,2>{ 1., 2. };
+  auto x = Dune::FieldVector<double,2>(0.);
+
+  auto cg = Dune::FixedSizeCGSolver<double,2>( A, Dune::KrylovTerminationCriterion::ResidualBased<double>(1e-12) );
+  Dune::InverseOperatorResult res;
+  cg.apply(x,b,res);
+
+  EXPECT_TRUE( res.converged );
+  EXPECT_EQ( res.iterations, 2 );
+  EXPECT_NEAR( x[0], 1./11, 1e-12 );
+  EXPECT_NEAR( x[1], 7./11, 1e-12 );
+}
+
+TEST(FixedSizeCGSolver,JacobiPreconditioner)
+{
+  auto A = tridiagonalMatrix();
+  auto b = Vector(1.);
+  auto x = Vector(0.);
+
+  auto cg = Dune::FixedSizeCGSolver< double, 6, Dune::KrylovTerminationCriterion::ResidualBased<double>,
+                                     Dune::FixedSizeCGSpec::JacobiPreconditioner<double,6> >( A, Dune::KrylovTerminationCriterion::ResidualBased<double>(1e-12) );
+  Dune::InverseOperatorResult res;
+  cg.apply(x,b,res);
+
+  EXPECT_TRUE( res.converged );
+  EXPECT_LE( res.iterations, 6 );
+  checkSolution(A,x,b,1e-10);
+}
+
+TEST(FixedSizeCGSolver,RelativeEnergyError)
+{
+  auto A = tridiagonalMatrix();
+  auto b = Vector(1.);
+  auto x = Vector(0.);
+
+  auto terminationCriterion = Dune::KrylovTerminationCriterion::RelativeEnergyError<double>(1e-10);
+  terminationCriterion.setLookAhead(1);
+  auto cg = Dune::FixedSizeCGSolver< double, 6, Dune::KrylovTerminationCriterion::RelativeEnergyError<double> >( A, terminationCriterion );
+  cg.apply(x,b);
+
+  checkSolution(A,x,b,1e-8);
+
+  // copies are connected to their own state
+  auto copy = cg;
+  x = 0.;
+  copy.apply(x,b);
+  checkSolution(A,x,b,1e-8);
+}
+
+TEST(FixedSizeCGSolver,MaxSteps)
+{
+  auto A = tridiagonalMatrix();
+  auto b = Vector(1.);
+  auto x = Vector(0.);
+
+  auto cg = Dune::FixedSizeCGSolver<double,6>( A, Dune::KrylovTerminationCriterion::ResidualBased<double>(1e-12), 1 );
+  Dune::InverseOperatorResult res;
+  cg.apply(x,b,res);
+  EXPECT_FALSE( res.converged );
+}
@@ -0,0 +1,42 @@
+#include <gtest/gtest.h>
+
+#include "dune/istl/solvers.hh"
+#include "../fixed_steps_termination_criterion.hh"
+
+#include "mock/step.hh"
+
+namespace
+{
+  struct TestFixedStepsTerminationCriterion : ::testing::Test
+  {
+    TestFixedStepsTerminationCriterion()
+    {
+      terminationCriterion.connect(step);
+      terminationCriterion.init();
+    }
+
+    Dune::KrylovTerminationCriterion::FixedSteps<double> terminationCriterion;
+    Dune::Mock::Step step;
+  };
+}
+
+
+TEST_F(TestFixedStepsTerminationCriterion, Terminate)
+{
+  terminationCriterion.setMaxSteps( 3 );
+
+  ASSERT_FALSE( static_cast<bool>(terminationCriterion) );
+  ASSERT_FALSE( static_cast<bool>(terminationCriterion) );
+  ASSERT_TRUE( static_cast<bool>(terminationCriterion) );
+}
+
+TEST_F(TestFixedStepsTerminationCriterion, Print)
+{
+  terminationCriterion.setMaxSteps( 2 );
+  static_cast<bool>(terminationCriterion);
+  static_cast<bool>(terminationCriterion);
+
+  Dune::InverseOperatorResult res;
+  terminationCriterion.print(res);
+  ASSERT_EQ( res.iterations, 2 );
+}
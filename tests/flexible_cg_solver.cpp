@@ -0,0 +1,164 @@
+#include <gtest/gtest.h>
+
+#include <dune/common/fmatrix.hh>
+#include <dune/common/fvector.hh>
+#include <dune/istl/operators.hh>
+#include <dune/istl/scalarproducts.hh>
+
+#include "dune/istl/solvers.hh"
+#include "../cg_solver.hh"
+#include "../flexible_cg_solver.hh"
+#include "../residual_based_termination_criterion.hh"
+
+namespace
+{
+  constexpr int n = 20;
+  using Vector = Dune::FieldVector<double,n>;
+  using Matrix = Dune::FieldMatrix<double,n,n>;
+
+  // a few steps of unpreconditioned cg, the number of steps varies between applications if variable = true
+  class InnerCGPreconditioner : public Dune::Preconditioner<Vector,Vector>
+  {
+  public:
+    InnerCGPreconditioner(const Matrix& A, bool variable)
+      : A_(A), variable_(variable)
+    {}
+
+    void pre(Vector&, Vector&) override {}
+
+    void apply(Vector& v, const Vector& d) override
+    {
+      auto steps = variable_ ? 1 + applications_++ % 4 : 3u;
+      v = 0.;
+      auto r = d, p = d;
+      auto Ap = Vector(0.);
+      auto sigma = r*r;
+      for( auto k = 0u; k < steps && sigma > 0; ++k )
+      {
+        A_.mv(p,Ap);
+        auto alpha = sigma/(p*Ap);
+        v.axpy(alpha,p);
+        r.axpy(-alpha,Ap);
+        auto newSigma = r*r;
+        p *= newSigma/sigma;
+        p += r;
+        sigma = newSigma;
+      }
+    }
+
+    void post(Vector&) override {}
+
+  private:
+    const Matrix& A_;
+    bool variable_;
+    unsigned applications_ = 0;
+  };
+
+  struct TestFlexibleCGSolver : ::testing::Test
+  {
+    TestFlexibleCGSolver()
+      : A(matrix)
+    {
+      for( int i = 0; i < n; ++i )
+      {
+        matrix[i][i] = 2 + 0.01*i*i;
+        if( i > 0 ) matrix[i][i-1] = matrix[i-1][i] = -1;
+      }
+    }
+
+    template <class Solver>
+    Dune::InverseOperatorResult solve(Solver& solver)
+    {
+      x = 0.; b = 1.;
+      Dune::InverseOperatorResult res;
+      solver.apply(x,b,res);
+
+      auto Ax = Vector(0.);
+      matrix.mv(x,Ax);
+      for( int i = 0; i < n; ++i )
+        EXPECT_NEAR( Ax[i], 1., 1e-8 );
+      return res;
+    }
+
+    Matrix matrix = Matrix(0.);
+    Dune::MatrixAdapter<Matrix,Vector,Vector> A;
+    Dune::SeqScalarProduct<Vector> sp;
+    Vector x, b;
+  };
+}
+
+
+TEST_F(TestFlexibleCGSolver,FixedPreconditioner)
+{
+  auto P = InnerCGPreconditioner(matrix,false);
+  auto cg = Dune::make_cg<Dune::MyCGSolver,Dune::KrylovTerminationCriterion::ResidualBased>(A,P,sp,1e-10,500);
+  auto fcg = Dune::make_cg<Dune::FlexibleCGSolver,Dune::KrylovTerminationCriterion::ResidualBased>(A,P,sp,1e-10,500);
+
+  auto cgRes = solve(cg);
+  auto res = solve(fcg);
+  EXPECT_TRUE( res.converged );
+  EXPECT_EQ( res.iterations, cgRes.iterations );
+}
+
+TEST_F(TestFlexibleCGSolver,VariablePreconditioner)
+{
+  auto P = InnerCGPreconditioner(matrix,true);
+  auto cg = Dune::make_cg<Dune::MyCGSolver,Dune::KrylovTerminationCriterion::ResidualBased>(A,P,sp,1e-10,500);
+  auto fcg = Dune::make_cg<Dune::FlexibleCGSolver,Dune::KrylovTerminationCriterion::ResidualBased>(A,P,sp,1e-10,500);
+
+  auto cgRes = solve(cg);
+  auto res = solve(fcg);
+  EXPECT_TRUE( res.converged );
+  EXPECT_LT( 2*res.iterations, cgRes.iterations );
+}
+
+TEST_F(TestFlexibleCGSolver,Truncation)
+{
+  auto P = InnerCGPreconditioner(matrix,false);
+  auto cg = Dune::make_cg<Dune::MyCGSolver,Dune::KrylovTerminationCriterion::ResidualBased>(A,P,sp,1e-10,500);
+  auto fcg = Dune::make_cg<Dune::FlexibleCGSolver,Dune::KrylovTerminationCriterion::ResidualBased>(A,P,sp,1e-10,500);
+  fcg.getStep().enableTruncation();
+
+  // FCG(1) coincides with cg for fixed preconditioners
+  auto cgRes = solve(cg);
+  auto res = solve(fcg);
+  EXPECT_TRUE( res.converged );
+  EXPECT_EQ( res.iterations, cgRes.iterations );
+}
+
+TEST_F(TestFlexibleCGSolver,TruncationWithVariablePreconditioner)
+{
+  auto P = InnerCGPreconditioner(matrix,true);
+  auto cg = Dune::make_cg<Dune::MyCGSolver,Dune::KrylovTerminationCriterion::ResidualBased>(A,P,sp,1e-10,500);
+  auto fcg = Dune::make_cg<Dune::FlexibleCGSolver,Dune::KrylovTerminationCriterion::ResidualBased>(A,P,sp,1e-10,500);
+  fcg.getStep().enableTruncation();
+
+  auto cgRes = solve(cg);
+  auto res = solve(fcg);
+  EXPECT_TRUE( res.converged );
+  EXPECT_LT( 2*res.iterations, cgRes.iterations );
+  EXPECT_EQ( fcg.getStep().restarts(), 0u );
+}
+
+TEST_F(TestFlexibleCGSolver,Restarts)
+{
+  auto P = InnerCGPreconditioner(matrix,true);
+  auto fcg = Dune::make_cg<Dune::FlexibleCGSolver,Dune::KrylovTerminationCriterion::ResidualBased>(A,P,sp,1e-10,500);
+  fcg.getStep().enableRestarts();
+  auto res = solve(fcg);
+  EXPECT_TRUE( res.converged );
+  EXPECT_LE( fcg.getStep().restarts(), static_cast<unsigned>(res.iterations) );
+
+  // consecutive preconditioned residuals are never exactly orthogonal, i.e. this degenerates to steepest descent
+  fcg.getStep().enableRestarts(1e-12);
+  solve(fcg);
+  EXPECT_GT( fcg.getStep().restarts(), 0u );
+
+  fcg.getStep().enableTruncation();
+  solve(fcg);
+  EXPECT_GT( fcg.getStep().restarts(), 0u );
+
+  fcg.getStep().disableRestarts();
+  solve(fcg);
+  EXPECT_EQ( fcg.getStep().restarts(), 0u );
+}
@@ -0,0 +1,96 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+
+#include <dune/istl/solvers.hh>
+
+#include "../forcing_term.hh"
+#include "../generic_iterative_method.hh"
+#include "../residual_based_termination_criterion.hh"
+
+#include "mock/step.hh"
+#include "mock/termination_criteria.hh"
+#include "mock/vector.hh"
+
+namespace Mock = Dune::Mock;
+
+using Mock::Step;
+using Mock::MixinTerminationCriterion;
+
+TEST(EisenstatWalkerForcingTerm,InitialForcingTerm)
+{
+  auto forcingTerm = Dune::EisenstatWalkerForcingTerm<>( 0.5 );
+  auto iterativeMethod = Dune::makeGenericIterativeMethod( Step(), MixinTerminationCriterion<Step>() );
+  forcingTerm.connect( iterativeMethod );
+
+  EXPECT_DOUBLE_EQ( iterativeMethod.getTerminationCriterion().relativeAccuracy(), 0.5 );
+  EXPECT_DOUBLE_EQ( iterativeMethod.getTerminationCriterion().minimalAccuracy(), 0.9 );
+
+  forcingTerm.setNonlinearResidual( 1 );
+  EXPECT_DOUBLE_EQ( forcingTerm.forcingTerm(), 0.5 );
+}
+
+TEST(EisenstatWalkerForcingTerm,FastConvergenceTightensAccuracy)
+{
+  auto forcingTerm = Dune::EisenstatWalkerForcingTerm<>( 0.5, 0.9, 2 );
+  auto iterativeMethod = Dune::makeGenericIterativeMethod( Step(), MixinTerminationCriterion<Step>() );
+  forcingTerm.connect( iterativeMethod );
+
+  forcingTerm.setNonlinearResidual( 1 );
+  // gamma * 0.1^2 = 0.009, the safeguard gamma * 0.5^2 = 0.225 exceeds 0.1
+  forcingTerm.setNonlinearResidual( 0.1 );
+  EXPECT_DOUBLE_EQ( forcingTerm.forcingTerm(), 0.225 );
+  // gamma * 0.1^2 = 0.009, the safeguard gamma * 0.225^2 < 0.1 is not used
+  forcingTerm.setNonlinearResidual( 0.01 );
+  EXPECT_DOUBLE_EQ( forcingTerm.forcingTerm(), 0.009 );
+
+  EXPECT_DOUBLE_EQ( iterativeMethod.getTerminationCriterion().relativeAccuracy(), 0.009 );
+  EXPECT_DOUBLE_EQ( iterativeMethod.getTerminationCriterion().minimalAccuracy(), 0.09 );
+}
+
+TEST(EisenstatWalkerForcingTerm,SlowConvergenceIsBounded)
+{
+  auto forcingTerm = Dune::EisenstatWalkerForcingTerm<>( 0.5, 0.9, 2, 0.8 );
+  forcingTerm.setNonlinearResidual( 1 );
+  forcingTerm.setNonlinearResidual( 2 );
+  EXPECT_DOUBLE_EQ( forcingTerm.forcingTerm(), 0.8 );
+  EXPECT_DOUBLE_EQ( forcingTerm.minimalAccuracy(), 0.8 );
+}
+
+TEST(EisenstatWalkerForcingTerm,NoOversolving)
+{
+  auto forcingTerm = Dune::EisenstatWalkerForcingTerm<>();
+  forcingTerm.setNonlinearTolerance( 1e-6 );
+  forcingTerm.setNonlinearResidual( 1 );
+  forcingTerm.setNonlinearResidual( 1e-2 );
+  forcingTerm.setNonlinearResidual( 1e-5 );
+  EXPECT_DOUBLE_EQ( forcingTerm.forcingTerm(), 0.05 );
+
+  forcingTerm.reset();
+  forcingTerm.setNonlinearResidual( 1e-5 );
+  EXPECT_DOUBLE_EQ( forcingTerm.forcingTerm(), 0.5 );
+}
+
+TEST(EisenstatWalkerForcingTerm,Disconnect)
+{
+  auto forcingTerm = Dune::EisenstatWalkerForcingTerm<>();
+  auto iterativeMethod = Dune::makeGenericIterativeMethod( Step(), MixinTerminationCriterion<Step>() );
+  forcingTerm.connect( iterativeMethod );
+  forcingTerm.disconnect( iterativeMethod );
+
+  forcingTerm.setNonlinearResidual( 1 );
+  forcingTerm.setNonlinearResidual( 1e-2 );
+  EXPECT_DOUBLE_EQ( iterativeMethod.getTerminationCriterion().relativeAccuracy(), 0.5 );
+}
+
+TEST(EisenstatWalkerForcingTerm,CriterionWithoutMinimalAccuracy)
+{
+  auto forcingTerm = Dune::EisenstatWalkerForcingTerm<>( 0.5 );
+  auto iterativeMethod = Dune::makeGenericIterativeMethod( Step(), Dune::KrylovTerminationCriterion::ResidualBased<double>() );
+  forcingTerm.connect( iterativeMethod );
+  EXPECT_DOUBLE_EQ( iterativeMethod.getTerminationCriterion().relativeAccuracy(), 0.5 );
+
+  forcingTerm.setNonlinearResidual( 1 );
+  forcingTerm.setNonlinearResidual( 0.01 );
+  EXPECT_DOUBLE_EQ( iterativeMethod.getTerminationCriterion().relativeAccuracy(), forcingTerm.forcingTerm() );
+}
@@ -1,4 +1,6 @@
+#include <limits>
 #include <string>
+#include <thread>
 
 #include <gtest/gtest.h>
 
@@ -24,6 +26,51 @@ namespace
   {
     return 1e-6;
   }
+
+  struct CountingStep : Step
+  {
+    void compute(Mock::Vector&, Mock::Vector&)
+    {
+      ++iterations;
+    }
+
+    unsigned iterations = 0;
+  };
+
+  // counts the created caches
+  struct CachingStep : Step
+  {
+    struct Cache
+    {
+      Cache(Mock::Vector&, Mock::Vector&)
+      {
+        ++constructions;
+      }
+
+      static unsigned constructions;
+    };
+
+    void setCache(Cache* newCache)
+    {
+      cache = newCache;
+    }
+
+    Cache* cache = nullptr;
+  };
+
+  unsigned CachingStep::Cache::constructions = 0;
+
+  struct AlwaysRestartingStep : RestartingStep
+  {
+    AlwaysRestartingStep()
+      : RestartingStep(true)
+    {}
+
+    bool terminate() const
+    {
+      return false;
+    }
+  };
 }
 
 
@@ -116,3 +163,195 @@ TEST(GenericIterativeMethod,MixinParameters)
   EXPECT_EQ( iterativeMethod.getTerminationCriterion().verbosityLevel() , 2u );
   EXPECT_TRUE( iterativeMethod.getTerminationCriterion().is_verbose() );
 }
+
+TEST(GenericIterativeMethod,RestartStorageReusesBuffers)
+{
+  Dune::Detail::Storage<Mock::Vector,Mock::Vector,RestartingStep> storage;
+  auto x = Mock::Vector( { 1., 2. } ), b = Mock::Vector( { 3., 4. } );
+  storage.store(x,b);
+  auto x0 = storage.x0.get();
+  auto b0 = storage.b0.get();
+
+  x[0] = 5;
+  b[1] = 6;
+  storage.store(x,b);
+  EXPECT_EQ( storage.x0.get(), x0 );
+  EXPECT_EQ( storage.b0.get(), b0 );
+
+  x *= 0;
+  b *= 0;
+  storage.restore(x,b);
+  EXPECT_DOUBLE_EQ( x[0], 5 );
+  EXPECT_DOUBLE_EQ( b[1], 6 );
+}
+
+TEST(GenericIterativeMethod,RestartStorageForZeroInitialGuess)
+{
+  Dune::Detail::Storage<Mock::Vector,Mock::Vector,RestartingStep> storage;
+  storage.setMode( Dune::RestartStorage::ZeroInitialGuess );
+  auto x = Mock::Vector( { 0., 0. } ), b = Mock::Vector( { 3., 4. } );
+  storage.store(x,b);
+  EXPECT_FALSE( storage.x0 );
+
+  x[0] = 1;
+  b[0] = 0;
+  storage.restore(x,b);
+  EXPECT_DOUBLE_EQ( x[0], 0 );
+  EXPECT_DOUBLE_EQ( b[0], 3 );
+}
+
+TEST(GenericIterativeMethod,CacheReuse)
+{
+  CachingStep::Cache::constructions = 0;
+  auto iterativeMethod = Dune::makeGenericIterativeMethod(CachingStep(),TerminationCriterion<CachingStep>());
+  auto x = Mock::Vector( { 1., 2. } ), b = Mock::Vector( { 3., 4. } );
+  iterativeMethod.apply(x,b);
+  iterativeMethod.apply(x,b);
+  EXPECT_EQ( CachingStep::Cache::constructions, 2u );
+
+  iterativeMethod.enableCacheReuse();
+  iterativeMethod.apply(x,b);
+  auto* cache = iterativeMethod.getStep().cache;
+  iterativeMethod.apply(x,b);
+  EXPECT_EQ( CachingStep::Cache::constructions, 3u );
+  EXPECT_EQ( iterativeMethod.getStep().cache, cache );
+
+  // the cache is recreated for other vectors, resp. other sizes
+  auto y = x;
+  iterativeMethod.apply(y,b);
+  EXPECT_EQ( CachingStep::Cache::constructions, 4u );
+  y = Mock::Vector( { 1., 2., 3. } );
+  iterativeMethod.apply(y,b);
+  EXPECT_EQ( CachingStep::Cache::constructions, 5u );
+
+  // copies do not share the cache
+  auto copy = iterativeMethod;
+  copy.apply(y,b);
+  EXPECT_EQ( CachingStep::Cache::constructions, 6u );
+  EXPECT_NE( copy.getStep().cache, iterativeMethod.getStep().cache );
+}
+
+TEST(GenericIterativeMethod,RestartWithoutStorageThrows)
+{
+  RestartingStep step(true);
+  auto iterativeMethod = Dune::makeGenericIterativeMethod(step,TerminationCriterion<RestartingStep>(false));
+  iterativeMethod.setRestartStorage( Dune::RestartStorage::None );
+  iterativeMethod.setMaxSteps(1);
+  Mock::Vector x, b;
+
+  Dune::InverseOperatorResult info;
+  EXPECT_THROW( iterativeMethod.apply(x,b,info), std::runtime_error );
+}
+
+TEST(GenericIterativeMethod,DeadlineReached)
+{
+  auto iterativeMethod = Dune::makeGenericIterativeMethod(CountingStep(),TerminationCriterion<CountingStep>(false));
+  iterativeMethod.setTimeBudget( std::chrono::steady_clock::duration::zero(), 3 );
+  Mock::Vector x, b;
+
+  Dune::IterativeMethodResult result;
+  iterativeMethod.apply(x,b,result);
+  EXPECT_EQ( result.status, Dune::SolverStatus::DeadlineReached );
+  EXPECT_FALSE( result.converged );
+  EXPECT_DOUBLE_EQ( result.errorEstimate, 1 );
+  EXPECT_EQ( iterativeMethod.getStep().iterations, 3u );
+
+  iterativeMethod.removeTimeBudget();
+  iterativeMethod.setMaxSteps(10);
+  iterativeMethod.apply(x,b,result);
+  EXPECT_EQ( result.status, Dune::SolverStatus::MaxStepsReached );
+  EXPECT_EQ( iterativeMethod.getStep().iterations, 13u );
+}
+
+TEST(GenericIterativeMethod,DeadlineCompletesRestart)
+{
+  auto iterativeMethod = Dune::makeGenericIterativeMethod(AlwaysRestartingStep(),TerminationCriterion<AlwaysRestartingStep>(false));
+  iterativeMethod.setTimeBudget( std::chrono::steady_clock::duration::zero() );
+  Mock::Vector x, b;
+
+  Dune::IterativeMethodResult result;
+  iterativeMethod.apply(x,b,result);
+  EXPECT_EQ( result.status, Dune::SolverStatus::DeadlineReached );
+  EXPECT_TRUE( iterativeMethod.getStep().wasReset );
+}
+
+TEST(GenericIterativeMethod,CancelAndPublishProgress)
+{
+  auto iterativeMethod = Dune::makeGenericIterativeMethod(CountingStep(),TerminationCriterion<CountingStep>(false));
+  iterativeMethod.setMaxSteps( std::numeric_limits<unsigned>::max()-1 );
+  Dune::CancellationToken token;
+  Dune::SolverProgress progress;
+  iterativeMethod.setCancellationToken(token);
+  iterativeMethod.setProgress(progress);
+  Mock::Vector x, b;
+
+  std::thread scheduler( [&token,&progress]
+  {
+    while( progress.snapshot().iteration < 5 )
+      std::this_thread::yield();
+    token.cancel();
+  });
+
+  Dune::IterativeMethodResult result;
+  iterativeMethod.apply(x,b,result);
+  scheduler.join();
+
+  EXPECT_EQ( result.status, Dune::SolverStatus::Cancelled );
+  EXPECT_FALSE( result.converged );
+  auto snapshot = progress.snapshot();
+  EXPECT_GE( snapshot.iteration, 5u );
+  EXPECT_EQ( snapshot.iteration, iterativeMethod.getStep().iterations );
+  EXPECT_DOUBLE_EQ( snapshot.errorEstimate, 1 );
+  EXPECT_DOUBLE_EQ( snapshot.regularizationParameter, 0 );
+
+  // a cancelled token stops subsequent solves after the first iteration
+  iterativeMethod.apply(x,b,result);
+  EXPECT_EQ( result.status, Dune::SolverStatus::Cancelled );
+  EXPECT_EQ( progress.snapshot().iteration, 1u );
+
+  token.reset();
+  iterativeMethod.setMaxSteps(3);
+  iterativeMethod.apply(x,b,result);
+  EXPECT_EQ( result.status, Dune::SolverStatus::MaxStepsReached );
+}
+
+TEST(GenericIterativeMethod,CloneCopiesConfiguration)
+{
+  auto iterativeMethod = Dune::makeGenericIterativeMethod(Step(),MixinTerminationCriterion<Step>());
+  iterativeMethod.setRelativeAccuracy(testAccuracy());
+  iterativeMethod.setMaxSteps(7);
+  Dune::SolverProgress progress;
+  iterativeMethod.setProgress(progress);
+
+  auto clone = iterativeMethod.clone();
+  EXPECT_DOUBLE_EQ( clone.relativeAccuracy(), testAccuracy() );
+  EXPECT_DOUBLE_EQ( clone.getTerminationCriterion().relativeAccuracy(), testAccuracy() );
+  EXPECT_EQ( clone.maxSteps(), 7u );
+
+  // parameters are forwarded to the own termination criterion only
+  clone.setRelativeAccuracy(2*testAccuracy());
+  EXPECT_DOUBLE_EQ( clone.getTerminationCriterion().relativeAccuracy(), 2*testAccuracy() );
+  EXPECT_DOUBLE_EQ( iterativeMethod.getTerminationCriterion().relativeAccuracy(), testAccuracy() );
+
+  // the clone does not publish progress
+  Mock::Vector x, b;
+  clone.apply(x,b);
+  EXPECT_EQ( progress.snapshot().iteration, 0u );
+}
+
+TEST(GenericIterativeMethod,CopyAndMoveAssignment)
+{
+  auto iterativeMethod = Dune::makeGenericIterativeMethod(Step(),MixinTerminationCriterion<Step>());
+  auto other = Dune::makeGenericIterativeMethod(Step(),MixinTerminationCriterion<Step>());
+  other.setRelativeAccuracy(testAccuracy());
+
+  iterativeMethod = other;
+  EXPECT_DOUBLE_EQ( iterativeMethod.getTerminationCriterion().relativeAccuracy(), testAccuracy() );
+  iterativeMethod.setRelativeAccuracy(2*testAccuracy());
+  EXPECT_DOUBLE_EQ( iterativeMethod.getTerminationCriterion().relativeAccuracy(), 2*testAccuracy() );
+  EXPECT_DOUBLE_EQ( other.getTerminationCriterion().relativeAccuracy(), testAccuracy() );
+
+  iterativeMethod = std::move(other);
+  iterativeMethod.setEps(testAccuracy());
+  EXPECT_DOUBLE_EQ( iterativeMethod.getTerminationCriterion().eps(), testAccuracy() );
+}
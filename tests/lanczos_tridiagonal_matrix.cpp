@@ -0,0 +1,49 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+
+#include "../lanczos_tridiagonal_matrix.hh"
+
+namespace
+{
+  inline double testAccuracy()
+  {
+    return 1e-12;
+  }
+}
+
+TEST(LanczosTridiagonalMatrix,OneStep)
+{
+  auto lanczos = Dune::LanczosTridiagonalMatrix<double>();
+  lanczos.push_back( 0.5, 0 );
+
+  ASSERT_EQ( lanczos.size(), 1u );
+  EXPECT_NEAR( lanczos.smallestRitzValue(), 2, testAccuracy() );
+  EXPECT_NEAR( lanczos.largestRitzValue(), 2, testAccuracy() );
+  EXPECT_NEAR( lanczos.conditionNumber(), 1, testAccuracy() );
+}
+
+TEST(LanczosTridiagonalMatrix,TwoSteps)
+{
+  // T = [ 4 1 ; 1 3 ]
+  auto lanczos = Dune::LanczosTridiagonalMatrix<double>();
+  lanczos.push_back( 0.25, 0 );
+  lanczos.push_back( 4./11, 1./16 );
+
+  ASSERT_EQ( lanczos.size(), 2u );
+  EXPECT_NEAR( lanczos.smallestRitzValue(), (7-sqrt(5.))/2, testAccuracy() );
+  EXPECT_NEAR( lanczos.largestRitzValue(), (7+sqrt(5.))/2, testAccuracy() );
+  EXPECT_NEAR( lanczos.conditionNumber(), (7+sqrt(5.))/(7-sqrt(5.)), testAccuracy() );
+}
+
+TEST(LanczosTridiagonalMatrix,Clear)
+{
+  auto lanczos = Dune::LanczosTridiagonalMatrix<double>();
+  lanczos.push_back( 0.25, 0 );
+  lanczos.push_back( 4./11, 1./16 );
+  lanczos.clear();
+  lanczos.push_back( 0.5, 0 );
+
+  ASSERT_EQ( lanczos.size(), 1u );
+  EXPECT_NEAR( lanczos.largestRitzValue(), 2, testAccuracy() );
+}
@@ -0,0 +1,111 @@
+#include <gtest/gtest.h>
+
+#include <stdexcept>
+
+#include <dune/common/fmatrix.hh>
+#include <dune/common/fvector.hh>
+#include <dune/istl/operators.hh>
+#include <dune/istl/scalarproducts.hh>
+
+#include "dune/istl/solvers.hh"
+#include "../mixed_precision_cg_solver.hh"
+#include "../residual_based_termination_criterion.hh"
+
+namespace
+{
+  using Vector = Dune::FieldVector<double,6>;
+  using Matrix = Dune::FieldMatrix<double,6,6>;
+  using LowVector = Dune::FieldVector<float,6>;
+  using LowMatrix = Dune::FieldMatrix<float,6,6>;
+
+  template <class V>
+  class JacobiPreconditioner : public Dune::Preconditioner<V,V>
+  {
+  public:
+    template <class M>
+    explicit JacobiPreconditioner(const M& A)
+    {
+      for( int i = 0; i < 6; ++i )
+        inverseDiagonal_[i] = 1/A[i][i];
+    }
+
+    void pre(V&, V&) override {}
+
+    void apply(V& v, const V& d) override
+    {
+      for( int i = 0; i < 6; ++i )
+        v[i] = inverseDiagonal_[i]*d[i];
+    }
+
+    void post(V&) override {}
+
+  private:
+    V inverseDiagonal_;
+  };
+
+  // tridiagonal matrix with diagonal (i+2) and off-diagonal -1
+  template <class M>
+  M tridiagonalMatrix()
+  {
+    auto A = M(0.);
+    for( int i = 0; i < 6; ++i )
+    {
+      A[i][i] = i+2;
+      if( i > 0 ) A[i][i-1] = A[i-1][i] = -1;
+    }
+    return A;
+  }
+
+  struct TestMixedPrecisionCGSolver : ::testing::Test
+  {
+    TestMixedPrecisionCGSolver()
+      : A(matrix), lowA(lowMatrix), P(matrix), lowP(lowMatrix)
+    {}
+
+    void checkSolution(double tolerance) const
+    {
+      auto Ax = Vector(0.);
+      matrix.mv(x,Ax);
+      for( int i = 0; i < 6; ++i )
+        EXPECT_NEAR( Ax[i], 1., tolerance );
+    }
+
+    Matrix matrix = tridiagonalMatrix<Matrix>();
+    LowMatrix lowMatrix = tridiagonalMatrix<LowMatrix>();
+    Dune::MatrixAdapter<Matrix,Vector,Vector> A;
+    Dune::MatrixAdapter<LowMatrix,LowVector,LowVector> lowA;
+    JacobiPreconditioner<Vector> P;
+    JacobiPreconditioner<LowVector> lowP;
+    Dune::SeqScalarProduct<Vector> sp;
+    // b is overwritten by the solver
+    Vector x = Vector(0.), b = Vector(1.);
+  };
+}
+
+
+TEST_F(TestMixedPrecisionCGSolver,AccuracyBeyondSinglePrecision)
+{
+  auto cg = Dune::make_cg<Dune::MixedPrecisionCGSolver,Dune::KrylovTerminationCriterion::ResidualBased>(A,P,sp,lowA,lowP,1e-12,100);
+  Dune::InverseOperatorResult res;
+  cg.apply(x,b,res);
+
+  EXPECT_TRUE( res.converged );
+  EXPECT_GT( cg.getStep().residualReplacements(), 0u );
+  checkSolution(1e-10);
+}
+
+TEST_F(TestMixedPrecisionCGSolver,WithoutResidualReplacement)
+{
+  auto cg = Dune::make_cg<Dune::MixedPrecisionCGSolver,Dune::KrylovTerminationCriterion::ResidualBased>(A,P,sp,lowA,lowP,1e-5,100);
+  cg.getStep().disableResidualReplacement();
+  cg.apply(x,b);
+
+  EXPECT_EQ( cg.getStep().residualReplacements(), 0u );
+  checkSolution(1e-4);
+}
+
+TEST_F(TestMixedPrecisionCGSolver,RequiresLowPrecisionOperators)
+{
+  auto cg = Dune::make_cg<Dune::MixedPrecisionCGSolver,Dune::KrylovTerminationCriterion::ResidualBased>(A,P,sp);
+  EXPECT_THROW( cg.apply(x,b), std::runtime_error );
+}
@@ -0,0 +1,127 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+#include <dune/istl/scalarproducts.hh>
+
+#include "mock/linearOperator_2d.hh"
+#include "mock/trivialPreconditioner.hh"
+#include "mock/vector.hh"
+
+#include "../cg_solver.hh"
+#include "../parallel_batch_solver.hh"
+#include "../projection_initial_guess.hh"
+#include "../residual_based_termination_criterion.hh"
+
+namespace Mock = Dune::Mock;
+using Mock::Vector;
+
+namespace
+{
+  struct ScalarProduct : Dune::ScalarProduct<Vector>
+  {
+    static constexpr int category = Dune::SolverCategory::sequential;
+
+    typename Dune::ScalarProduct<Vector>::field_type dot(const Vector& x, const Vector& y) final override
+    {
+      double result = 0;
+      for ( std::size_t i = 0; i < x.data_.size(); ++i )
+        result += x.data_[i] * y.data_[i];
+      return result;
+    }
+
+   double norm(const Vector& x) final override
+    {
+      return sqrt(dot(x,x));
+    }
+  };
+
+  using Solver = Dune::MyCGSolver< Vector, Vector, Dune::KrylovTerminationCriterion::ResidualBased >;
+
+  struct TestParallelBatchSolver : ::testing::Test
+  {
+    TestParallelBatchSolver()
+      // two steps solve the 2d problems exactly
+      : batchSolver( [this]{ return Solver( A, P, sp, Dune::KrylovTerminationCriterion::ResidualBased<double>(1e-12), 2 ); }, 4 )
+    {
+      for( auto i = 0; i < 37; ++i )
+      {
+        x.push_back( Vector( { 0., 0. } ) );
+        b.push_back( Vector( { 1.+i, 2. } ) );
+      }
+    }
+
+    Mock::LinearOperator_2d A;
+    Mock::TrivialPreconditioner P;
+    ScalarProduct sp;
+    Dune::ParallelBatchSolver<Solver> batchSolver;
+    std::vector<Vector> x, b;
+    std::vector<Dune::InverseOperatorResult> res;
+  };
+}
+
+
+TEST_F(TestParallelBatchSolver,SolvesAllSystems)
+{
+  EXPECT_EQ( batchSolver.numberOfThreads(), 4u );
+  batchSolver.apply(x,b,res);
+
+  ASSERT_EQ( res.size(), x.size() );
+  for( auto i = 0u; i < x.size(); ++i )
+  {
+    // solution of [[4,1],[1,3]] x = (1+i,2)
+    EXPECT_EQ( res[i].iterations, 2 );
+    EXPECT_NEAR( x[i].data_[0], ( 3.*(1.+i) - 2. )/11, 1e-10 );
+    EXPECT_NEAR( x[i].data_[1], ( 8. - (1.+i) )/11, 1e-10 );
+  }
+}
+
+TEST_F(TestParallelBatchSolver,ReusesSolvers)
+{
+  batchSolver.apply(x,b,res);
+  auto* solver = &batchSolver.getSolver(0);
+
+  x.assign( x.size(), Vector( { 0., 0. } ) );
+  b.assign( x.size(), Vector( { 1., 2. } ) );
+  batchSolver.apply(x,b,res);
+  EXPECT_EQ( &batchSolver.getSolver(0), solver );
+  for( auto i = 0u; i < x.size(); ++i )
+    EXPECT_NEAR( x[i].data_[0], 1./11, 1e-10 );
+}
+
+TEST_F(TestParallelBatchSolver,InconsistentSizesThrow)
+{
+  b.pop_back();
+  EXPECT_THROW( batchSolver.apply(x,b,res), std::invalid_argument );
+}
+
+TEST_F(TestParallelBatchSolver,ClonesPrototype)
+{
+  auto cg = Solver( A, P, sp, Dune::KrylovTerminationCriterion::ResidualBased<double>(1e-12), 2 );
+  Dune::ParallelBatchSolver<Solver> clonedBatchSolver( cg, 3 );
+  EXPECT_EQ( clonedBatchSolver.numberOfThreads(), 3u );
+  EXPECT_EQ( clonedBatchSolver.getSolver(2).maxSteps(), 2u );
+
+  clonedBatchSolver.apply(x,b,res);
+  for( auto i = 0u; i < x.size(); ++i )
+    EXPECT_NEAR( x[i].data_[1], ( 8. - (1.+i) )/11, 1e-10 );
+}
+
+TEST_F(TestParallelBatchSolver,ClonesDoNotShareInitialGuess)
+{
+  Dune::ProjectionInitialGuess<Vector,Vector> initialGuess( A, sp, 2 );
+  auto cg = Solver( A, P, sp, Dune::KrylovTerminationCriterion::ResidualBased<double>(1e-12), 2 );
+  cg.setInitialGuess( initialGuess );
+  Dune::ParallelBatchSolver<Solver> clonedBatchSolver( cg, 4 );
+
+  // the solvers of the threads do not write to the generator of the prototype
+  clonedBatchSolver.apply(x,b,res);
+  EXPECT_EQ( initialGuess.size(), 0u );
+  for( auto i = 0u; i < x.size(); ++i )
+  {
+    EXPECT_EQ( res[i].iterations, 2 );
+    EXPECT_NEAR( x[i].data_[0], ( 3.*(1.+i) - 2. )/11, 1e-10 );
+  }
+}
@@ -0,0 +1,210 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <vector>
+
+#include <dune/istl/operators.hh>
+#include <dune/istl/scalarproducts.hh>
+
+#include "mock/trivialPreconditioner.hh"
+#include "mock/vector.hh"
+
+#include "../cg_solver.hh"
+#include "../projection_initial_guess.hh"
+#include "../relative_energy_termination_criterion.hh"
+
+namespace Mock = Dune::Mock;
+using Mock::Vector;
+
+namespace
+{
+  const std::size_t n = 100;
+
+  struct ScalarProduct : Dune::ScalarProduct<Vector>
+  {
+    static constexpr int category = Dune::SolverCategory::sequential;
+
+    typename Dune::ScalarProduct<Vector>::field_type dot(const Vector& x, const Vector& y) final override
+    {
+      return x.dot(y);
+    }
+
+    double norm(const Vector& x) final override
+    {
+      return sqrt(dot(x,x));
+    }
+  };
+
+  // finite difference discretization of the one-dimensional Laplacian
+  struct Laplacian : Dune::LinearOperator<Vector,Vector>
+  {
+    static constexpr int category = Dune::SolverCategory::sequential;
+
+    void apply(const Vector& x, Vector& y) const final override
+    {
+      y *= 0;
+      applyscaleadd( 1, x, y );
+    }
+
+    void applyscaleadd(double a, const Vector& x, Vector& y) const final override
+    {
+      for( std::size_t i = 0; i < n; ++i )
+      {
+        y[i] += 2*a*x[i];
+        if( i > 0 )
+          y[i] -= a*x[i-1];
+        if( i+1 < n )
+          y[i] -= a*x[i+1];
+      }
+    }
+  };
+
+  Vector zero()
+  {
+    return Vector( std::vector<double>( n, 0. ) );
+  }
+
+  // slowly varying right hand sides, as in time stepping schemes
+  Vector rightHandSide(unsigned k)
+  {
+    auto b = zero();
+    for( std::size_t i = 0; i < n; ++i )
+      b[i] = sin( 3.14159 * (i+1) / (n+1) ) + 0.02 * k * cos( 0.1 * k * i );
+    return b;
+  }
+
+  struct TestProjectionInitialGuess : ::testing::Test
+  {
+    TestProjectionInitialGuess()
+      : A(), P(), sp(), initialGuess( A, sp, 4 )
+    {}
+
+    Vector solve(const Vector& rhs)
+    {
+      auto cg = Dune::MyCGSolver<Vector,Vector>( A, P, sp, Dune::KrylovTerminationCriterion::RelativeEnergyError<double>(1e-12) );
+      auto x = zero();
+      auto b = rhs;
+      cg.apply( x, b );
+      return x;
+    }
+
+    Laplacian A;
+    Mock::TrivialPreconditioner P;
+    ScalarProduct sp;
+    Dune::ProjectionInitialGuess<Vector,Vector> initialGuess;
+  };
+}
+
+TEST_F(TestProjectionInitialGuess,Empty)
+{
+  auto x = rightHandSide( 0 );
+  auto energy = initialGuess.apply( x, rightHandSide( 0 ) );
+
+  EXPECT_EQ( initialGuess.size(), 0u );
+  EXPECT_EQ( energy, 0 );
+  for( std::size_t i = 0; i < n; ++i )
+    EXPECT_EQ( x[i], 0 );
+}
+
+TEST_F(TestProjectionInitialGuess,ReproducesStoredSolution)
+{
+  auto b = rightHandSide( 1 );
+  auto solution = solve( b );
+  initialGuess.push_back( solution );
+
+  auto x = zero();
+  auto energy = initialGuess.apply( x, b );
+
+  ASSERT_EQ( initialGuess.size(), 1u );
+  for( std::size_t i = 0; i < n; ++i )
+    EXPECT_NEAR( x[i], solution[i], 1e-8 );
+  EXPECT_NEAR( energy, sp.dot( solution, b ), 1e-8 );
+}
+
+TEST_F(TestProjectionInitialGuess,BoundedWindow)
+{
+  for( auto k = 0u; k < 10u; ++k )
+    initialGuess.push_back( rightHandSide( k ) );
+  EXPECT_EQ( initialGuess.size(), initialGuess.windowSize() );
+
+  initialGuess.clear();
+  EXPECT_EQ( initialGuess.size(), 0u );
+
+  // linearly dependent directions are not stored
+  auto x = rightHandSide( 1 );
+  initialGuess.push_back( x );
+  x *= 2;
+  initialGuess.push_back( x );
+  EXPECT_EQ( initialGuess.size(), 1u );
+}
+
+TEST_F(TestProjectionInitialGuess,WarmStartReducesIterations)
+{
+  auto cg = Dune::MyCGSolver<Vector,Vector>( A, P, sp, Dune::KrylovTerminationCriterion::RelativeEnergyError<double>(1e-8) );
+  cg.setInitialGuess( initialGuess );
+
+  auto coldIterations = 0u, warmIterations = 0u;
+  for( auto k = 0u; k < 6u; ++k )
+  {
+    auto x = zero();
+    auto b = rightHandSide( k );
+    Dune::InverseOperatorResult res;
+    cg.apply( x, b, res );
+    if( k > 0 )
+      warmIterations += res.iterations;
+
+    auto coldCG = Dune::MyCGSolver<Vector,Vector>( A, P, sp, Dune::KrylovTerminationCriterion::RelativeEnergyError<double>(1e-8) );
+    auto y = zero();
+    b = rightHandSide( k );
+    coldCG.apply( y, b, res );
+    if( k > 0 )
+      coldIterations += res.iterations;
+
+    // the error estimate stays valid for the nonzero initial guess
+    auto solution = solve( rightHandSide( k ) );
+    auto error = x;
+    error.axpy( -1, solution );
+    auto Aerror = zero();
+    A.apply( error, Aerror );
+    auto Asolution = zero();
+    A.apply( solution, Asolution );
+    EXPECT_LT( sqrt( sp.dot( error, Aerror ) / sp.dot( solution, Asolution ) ), 1e-6 );
+  }
+
+  EXPECT_LT( warmIterations, coldIterations );
+  EXPECT_EQ( initialGuess.size(), initialGuess.windowSize() );
+}
+
+TEST_F(TestProjectionInitialGuess,CloneDoesNotShareInitialGuess)
+{
+  auto cg = Dune::MyCGSolver<Vector,Vector>( A, P, sp, Dune::KrylovTerminationCriterion::RelativeEnergyError<double>(1e-8) );
+  cg.setInitialGuess( initialGuess );
+  auto x = zero();
+  auto b = rightHandSide( 0 );
+  cg.apply( x, b );
+  ASSERT_EQ( initialGuess.size(), 1u );
+
+  // the clone neither reads from nor writes to the generator of the prototype
+  auto clone = cg.clone();
+  auto y = rightHandSide( 1 );
+  b = rightHandSide( 1 );
+  auto y0 = y;
+  Dune::InverseOperatorResult res;
+  clone.apply( y, b, res );
+  EXPECT_EQ( initialGuess.size(), 1u );
+
+  auto reference = Dune::MyCGSolver<Vector,Vector>( A, P, sp, Dune::KrylovTerminationCriterion::RelativeEnergyError<double>(1e-8) );
+  b = rightHandSide( 1 );
+  Dune::InverseOperatorResult referenceRes;
+  reference.apply( y0, b, referenceRes );
+  EXPECT_EQ( res.iterations, referenceRes.iterations );
+
+  // a separate generator may be set for the clone
+  Dune::ProjectionInitialGuess<Vector,Vector> otherInitialGuess( A, sp, 4 );
+  clone.setInitialGuess( otherInitialGuess );
+  y = zero();
+  b = rightHandSide( 1 );
+  clone.apply( y, b );
+  EXPECT_EQ( otherInitialGuess.size(), 1u );
+  EXPECT_EQ( initialGuess.size(), 1u );
+}
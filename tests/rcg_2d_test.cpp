@@ -1,6 +1,10 @@
 #include <gtest/gtest.h>
 
 #include <cmath>
+#include <limits>
+#include <memory>
+#include <type_traits>
+#include <vector>
 
 #include <dune/istl/scalarproducts.hh>
 
@@ -55,6 +59,95 @@ namespace
     Dune::RCGSolver< Vector, Vector , Dune::KrylovTerminationCriterion::ResidualBased > cg;
   };
 
+  // indefinite operator diag(-1,2) that counts its applications
+  struct IndefiniteOperator : Dune::LinearOperator<Vector,Vector>
+  {
+    static constexpr int category = Dune::SolverCategory::sequential;
+
+    void apply(const Vector& x, Vector& y) const final override
+    {
+      ++numberOfApplications;
+      y.data_[0] = -x.data_[0];
+      y.data_[1] = 2*x.data_[1];
+    }
+
+    void applyscaleadd(double a, const Vector& x, Vector& y) const final override
+    {
+      y.data_[0] -= a*x.data_[0];
+      y.data_[1] += 2*a*x.data_[1];
+    }
+
+    mutable unsigned numberOfApplications = 0;
+  };
+
+  // diagonal operator diag(-1,2,...,n) that counts its applications
+  struct DiagonalOperator : Dune::LinearOperator<Vector,Vector>
+  {
+    static constexpr int category = Dune::SolverCategory::sequential;
+
+    explicit DiagonalOperator(std::size_t n)
+      : diagonal(n)
+    {
+      diagonal[0] = -1;
+      for( std::size_t i = 1; i < n; ++i )
+        diagonal[i] = i+1;
+    }
+
+    void apply(const Vector& x, Vector& y) const final override
+    {
+      ++numberOfApplications;
+      for( std::size_t i = 0; i < diagonal.size(); ++i )
+        y.data_[i] = diagonal[i]*x.data_[i];
+    }
+
+    void applyscaleadd(double a, const Vector& x, Vector& y) const final override
+    {
+      for( std::size_t i = 0; i < diagonal.size(); ++i )
+        y.data_[i] += a*diagonal[i]*x.data_[i];
+    }
+
+    std::vector<double> diagonal;
+    mutable unsigned numberOfApplications = 0;
+  };
+
+  struct TestRCGSolver_2d_Indefinite : ::testing::Test
+  {
+    TestRCGSolver_2d_Indefinite()
+      : A(), P(), sp(),
+        cg( A, P, sp, Dune::KrylovTerminationCriterion::ResidualBased<double>(1e-10) )
+    {
+    }
+
+    unsigned solve()
+    {
+      A.numberOfApplications = 0;
+      auto x = Vector( { 0., 0. } );
+      auto b = Vector( { 1., 1. } );
+      cg.apply(x,b);
+
+      // solution of the regularized problem (A+theta*I)x = b
+      auto theta = cg.getStep().regularizationParameter();
+      EXPECT_GT( theta, 1 );
+      EXPECT_NEAR( x.data_[0], 1/(theta-1), 1e-8 );
+      EXPECT_NEAR( x.data_[1], 1/(theta+2), 1e-8 );
+      return A.numberOfApplications;
+    }
+
+    IndefiniteOperator A;
+    Dune::Mock::TrivialPreconditioner P;
+    ScalarProduct sp;
+    Dune::RCGSolver< Vector, Vector , Dune::KrylovTerminationCriterion::ResidualBased > cg;
+  };
+
+  // detect if Step provides setTrustRegionRadius(double)
+  template <class Step, class = void>
+  struct HasTrustRegion : std::false_type
+  {};
+
+  template <class Step>
+  struct HasTrustRegion< Step, decltype( std::declval<Step&>().setTrustRegionRadius(1.), void() ) > : std::true_type
+  {};
+
   Vector initialGuess()
   {
     return Vector( { 2., 1. } );
@@ -111,3 +204,142 @@ TEST_F(TestRCGSolver_2d,TwoSteps)
   ASSERT_DOUBLE_EQ( x.data_[0], 0.0909090909090909 );
   ASSERT_DOUBLE_EQ( x.data_[1], 0.6363636363636364 );
 }
+
+TEST_F(TestRCGSolver_2d_Indefinite,RegularizationIsResetByDefault)
+{
+  auto first = solve();
+  auto theta = cg.getStep().regularizationParameter();
+
+  EXPECT_EQ( solve(), first );
+  EXPECT_DOUBLE_EQ( cg.getStep().regularizationParameter(), theta );
+}
+
+TEST_F(TestRCGSolver_2d_Indefinite,PersistentRegularizationAvoidsRestarts)
+{
+  cg.getStep().enablePersistentRegularization(1);
+  auto first = solve();
+  auto theta = cg.getStep().regularizationParameter();
+
+  // the second solve starts with sufficient regularization and does not restart
+  EXPECT_LT( solve(), first );
+  EXPECT_DOUBLE_EQ( cg.getStep().regularizationParameter(), theta );
+}
+
+TEST_F(TestRCGSolver_2d_Indefinite,PersistentRegularizationDecays)
+{
+  cg.getStep().enablePersistentRegularization(0.5);
+  solve();
+  auto theta = cg.getStep().regularizationParameter();
+
+  // the decayed regularization parameter is insufficient and doubled again
+  solve();
+  EXPECT_DOUBLE_EQ( cg.getStep().regularizationParameter(), theta );
+
+  cg.getStep().disablePersistentRegularization();
+  solve();
+  EXPECT_DOUBLE_EQ( cg.getStep().regularizationParameter(), theta );
+}
+
+TEST_F(TestRCGSolver_2d_Indefinite,ProgressContainsRegularizationParameter)
+{
+  Dune::SolverProgress progress;
+  cg.setProgress(progress);
+  solve();
+  EXPECT_DOUBLE_EQ( progress.snapshot().regularizationParameter, cg.getStep().regularizationParameter() );
+  EXPECT_LT( progress.snapshot().errorEstimate, 1e-10 );
+}
+
+TEST_F(TestRCGSolver_2d_Indefinite,InPlaceRegularization)
+{
+  auto withRestarts = solve();
+  EXPECT_GT( cg.getStep().restarts(), 0u );
+  EXPECT_EQ( cg.getStep().inPlaceRegularizations(), 0u );
+
+  // solves the regularized problem without restarting
+  cg.getStep().enableInPlaceRegularization();
+  EXPECT_LE( solve(), withRestarts );
+  EXPECT_EQ( cg.getStep().restarts(), 0u );
+  EXPECT_GT( cg.getStep().inPlaceRegularizations(), 0u );
+}
+
+TEST(RCGSolver,InPlaceRegularizationSavesOperatorApplications)
+{
+  // diag(-1,2,...,50), the nonconvexity is detected late due to the small component of the right hand side
+  auto A = DiagonalOperator( 50 );
+  Dune::Mock::TrivialPreconditioner P;
+  ScalarProduct sp;
+  auto operatorApplications = [&](bool inPlace)
+  {
+    auto cg = Dune::RCGSolver< Vector, Vector , Dune::KrylovTerminationCriterion::ResidualBased >( A, P, sp, Dune::KrylovTerminationCriterion::ResidualBased<double>(1e-10) );
+    if( inPlace )
+      cg.getStep().enableInPlaceRegularization();
+    auto x = Vector( std::vector<double>(50,0.) );
+    auto b = Vector( std::vector<double>(50,1.) );
+    b.data_[0] = 1e-2;
+    A.numberOfApplications = 0;
+    cg.apply(x,b);
+    return A.numberOfApplications;
+  };
+
+  auto withRestarts = operatorApplications(false);
+  EXPECT_LT( 3*operatorApplications(true), 2*withRestarts );
+}
+
+TEST_F(TestRCGSolver_2d_Indefinite,InPlaceRegularizationWithEnergyErrorEstimate)
+{
+  auto energyCG = Dune::RCGSolver< Vector, Vector >( A, P, sp, Dune::KrylovTerminationCriterion::RelativeEnergyError<double>(1e-10) );
+  energyCG.getStep().enableInPlaceRegularization();
+  auto x = Vector( { 0., 0. } );
+  auto b = Vector( { 1., 1. } );
+  energyCG.apply(x,b);
+
+  auto theta = energyCG.getStep().regularizationParameter();
+  EXPECT_GT( theta, 1 );
+  EXPECT_NEAR( x.data_[0], 1/(theta-1), 1e-8 );
+  EXPECT_NEAR( x.data_[1], 1/(theta+2), 1e-8 );
+}
+
+TEST_F(TestRCGSolver_2d_Indefinite,CloneCopiesStepParameters)
+{
+  cg.setEps(1e-3);
+  cg.setIterativeRefinements(3);
+  cg.setVerbosityLevel(2);
+  auto clone = cg.clone();
+  EXPECT_DOUBLE_EQ( clone.getStep().eps(), 1e-3 );
+  EXPECT_EQ( clone.getStep().iterativeRefinements(), 3u );
+  EXPECT_EQ( clone.getStep().verbosityLevel(), 2u );
+
+  // the substeps of the clone perform the iterative refinements as well
+  cg.setEps(std::numeric_limits<double>::epsilon());
+  cg.setVerbosityLevel(0);
+  clone.setEps(std::numeric_limits<double>::epsilon());
+  auto applications = solve();
+  auto x = Vector( { 0., 0. } );
+  auto b = Vector( { 1., 1. } );
+  A.numberOfApplications = 0;
+  clone.setVerbosityLevel(0);
+  clone.apply(x,b);
+  EXPECT_EQ( A.numberOfApplications, applications );
+}
+
+TEST_F(TestRCGSolver_2d_Indefinite,CloneOwnsDefaultScalarProduct)
+{
+  using Solver = Dune::RCGSolver< Vector, Vector , Dune::KrylovTerminationCriterion::ResidualBased >;
+  auto prototype = std::unique_ptr<Solver>( new Solver( A, P, Dune::KrylovTerminationCriterion::ResidualBased<double>(1e-10) ) );
+  auto clone = prototype->clone();
+  prototype.reset();
+
+  auto x = Vector( { 0., 0. } );
+  auto b = Vector( { 1., 1. } );
+  clone.apply(x,b);
+  auto theta = clone.getStep().regularizationParameter();
+  EXPECT_NEAR( x.data_[0], 1/(theta-1), 1e-8 );
+  EXPECT_NEAR( x.data_[1], 1/(theta+2), 1e-8 );
+}
+
+TEST(RCGSolver,NoTrustRegion)
+{
+  // the trust region is only respected by the truncated conjugate gradient method
+  static_assert( HasTrustRegion< Dune::TCGSpec::Step<Vector> >::value, "" );
+  static_assert( !HasTrustRegion< Dune::RCGSpec::Step<Vector> >::value, "" );
+}
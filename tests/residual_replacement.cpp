@@ -0,0 +1,145 @@
+#include <gtest/gtest.h>
+
+#include <dune/common/fmatrix.hh>
+#include <dune/common/fvector.hh>
+#include <dune/istl/operators.hh>
+#include <dune/istl/scalarproducts.hh>
+
+#include "dune/istl/solvers.hh"
+#include "../residual_replacement.hh"
+#include "../residual_based_termination_criterion.hh"
+
+namespace
+{
+  using Vector = Dune::FieldVector<double,6>;
+  using Matrix = Dune::FieldMatrix<double,6,6>;
+
+  class IdentityPreconditioner : public Dune::Preconditioner<Vector,Vector>
+  {
+  public:
+    void pre(Vector&, Vector&) override {}
+
+    void apply(Vector& v, const Vector& d) override
+    {
+      v = d;
+    }
+
+    void post(Vector&) override {}
+  };
+
+  struct TestResidualReplacement : ::testing::Test
+  {
+    TestResidualReplacement()
+      : A(matrix)
+    {
+      // tridiagonal matrix with diagonal (i+2) and off-diagonal -1
+      for( int i = 0; i < 6; ++i )
+      {
+        matrix[i][i] = i+2;
+        if( i > 0 ) matrix[i][i-1] = matrix[i-1][i] = -1;
+      }
+    }
+
+    void checkSolution(double tolerance) const
+    {
+      auto Ax = Vector(0.);
+      matrix.mv(x,Ax);
+      for( int i = 0; i < 6; ++i )
+        EXPECT_NEAR( Ax[i], 1., tolerance );
+    }
+
+    Matrix matrix = Matrix(0.);
+    Dune::MatrixAdapter<Matrix,Vector,Vector> A;
+    IdentityPreconditioner P;
+    Dune::SeqScalarProduct<Vector> sp;
+    // b is overwritten by the solver
+    Vector x = Vector(0.), b = Vector(1.);
+  };
+}
+
+
+TEST_F(TestResidualReplacement,MatchesCG)
+{
+  auto cg = Dune::make_cg<Dune::MyCGSolver,Dune::KrylovTerminationCriterion::ResidualBased>(A,P,sp,1e-12,100);
+  Dune::InverseOperatorResult cgRes;
+  cg.apply(x,b,cgRes);
+
+  x = 0.; b = 1.;
+  auto rcg = Dune::make_cg<Dune::ResidualReplacementCGSolver,Dune::KrylovTerminationCriterion::ResidualBased>(A,P,sp,1e-12,100);
+  Dune::InverseOperatorResult res;
+  rcg.apply(x,b,res);
+
+  EXPECT_TRUE( res.converged );
+  EXPECT_EQ( res.iterations, cgRes.iterations );
+  checkSolution(1e-10);
+}
+
+TEST_F(TestResidualReplacement,NoReplacementForLargeResiduals)
+{
+  // the gap only becomes relevant if the residual approaches sqrt(eps) times the gap
+  auto cg = Dune::make_cg<Dune::ResidualReplacementCGSolver,Dune::KrylovTerminationCriterion::ResidualBased>(A,P,sp,1e-12,4);
+  cg.apply(x,b);
+  EXPECT_EQ( cg.getStep().residualReplacements(), 0u );
+}
+
+TEST_F(TestResidualReplacement,ReplacesResidual)
+{
+  auto cg = Dune::make_cg<Dune::ResidualReplacementCGSolver,Dune::KrylovTerminationCriterion::ResidualBased>(A,P,sp,1e-12,100);
+  // pretend low accuracy of the recursive update to trigger replacements
+  cg.getStep().setUnitRoundoff(1e-4);
+  cg.getStep().setOperatorNorm(8.);
+  Dune::InverseOperatorResult res;
+  cg.apply(x,b,res);
+
+  EXPECT_TRUE( res.converged );
+  EXPECT_GT( cg.getStep().residualReplacements(), 0u );
+  EXPECT_GT( cg.getStep().residualReplacementTime(), 0. );
+  checkSolution(1e-10);
+
+  // statistics refer to the last solve
+  auto replacements = cg.getStep().residualReplacements();
+  x = 0.; b = 1.;
+  cg.apply(x,b,res);
+  EXPECT_EQ( cg.getStep().residualReplacements(), replacements );
+}
+
+TEST_F(TestResidualReplacement,IndependentOfMaximalAttainableAccuracy)
+{
+  auto cg = Dune::make_cg<Dune::ResidualReplacementCGSolver,Dune::KrylovTerminationCriterion::ResidualBased>(A,P,sp,1e-12,100);
+  cg.apply(x,b);
+  auto replacements = cg.getStep().residualReplacements();
+
+  // the maximal attainable accuracy of the iterative method does not affect the replacements
+  x = 0.; b = 1.;
+  cg.setEps(1e-4);
+  cg.apply(x,b);
+  EXPECT_EQ( cg.getStep().residualReplacements(), replacements );
+  checkSolution(1e-10);
+}
+
+TEST_F(TestResidualReplacement,MonitoringCostsOneNormPerStep)
+{
+  auto cg = Dune::make_cg<Dune::ResidualReplacementCGSolver,Dune::KrylovTerminationCriterion::ResidualBased>(A,P,sp,1e-12,100);
+  cg.getStep().setUnitRoundoff(1e-4);
+  cg.getStep().setOperatorNorm(8.);
+  Dune::InverseOperatorResult res;
+  cg.apply(x,b,res);
+
+  // norm of the initial iterate, one norm per step and two norms per replacement
+  auto replacements = cg.getStep().residualReplacements();
+  EXPECT_EQ( cg.getStep().residualReplacementReductions(), 1 + static_cast<unsigned>(res.iterations) + 2*replacements );
+}
+
+TEST_F(TestResidualReplacement,Disabled)
+{
+  auto cg = Dune::make_cg<Dune::ResidualReplacementCGSolver,Dune::KrylovTerminationCriterion::ResidualBased>(A,P,sp,1e-12,100);
+  cg.getStep().setUnitRoundoff(1e-4);
+  cg.getStep().disableResidualReplacement();
+  Dune::InverseOperatorResult res;
+  cg.apply(x,b,res);
+
+  EXPECT_TRUE( res.converged );
+  EXPECT_EQ( cg.getStep().residualReplacements(), 0u );
+  EXPECT_EQ( cg.getStep().residualReplacementReductions(), 0u );
+  EXPECT_EQ( cg.getStep().residualReplacementTime(), 0. );
+}
@@ -0,0 +1,189 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include <dune/common/fmatrix.hh>
+
+#include "../spectral_bounds.hh"
+
+namespace
+{
+  inline double testAccuracy()
+  {
+    return 1e-12;
+  }
+
+  using Block = Dune::FieldMatrix<double,1,1>;
+
+  // Minimal row-wise sparse matrix with the interface of Dune::BCRSMatrix used by SpectralBounds::gershgorinJacobi.
+  struct SparseMatrix
+  {
+    using field_type = double;
+
+    struct Row
+    {
+      struct ConstIterator
+      {
+        const Block& operator*() const
+        {
+          return row->blocks[i];
+        }
+
+        const Block* operator->() const
+        {
+          return &row->blocks[i];
+        }
+
+        ConstIterator& operator++()
+        {
+          ++i;
+          return *this;
+        }
+
+        bool operator!=(const ConstIterator& other) const
+        {
+          return i != other.i;
+        }
+
+        bool operator==(const ConstIterator& other) const
+        {
+          return i == other.i;
+        }
+
+        std::size_t index() const
+        {
+          return row->indices[i];
+        }
+
+        const Row* row;
+        std::size_t i;
+      };
+
+      ConstIterator begin() const
+      {
+        return ConstIterator{ this, 0 };
+      }
+
+      ConstIterator end() const
+      {
+        return ConstIterator{ this, indices.size() };
+      }
+
+      std::vector<std::size_t> indices;
+      std::vector<Block> blocks;
+    };
+
+    std::size_t N() const
+    {
+      return rows.size();
+    }
+
+    const Row& operator[](std::size_t i) const
+    {
+      return rows[i];
+    }
+
+    std::vector<Row> rows;
+  };
+
+  SparseMatrix laplacian1d(std::size_t n)
+  {
+    SparseMatrix A;
+    A.rows.resize( n );
+    for( std::size_t i = 0; i < n; ++i )
+    {
+      if( i > 0 )
+      {
+        A.rows[i].indices.push_back( i-1 );
+        A.rows[i].blocks.push_back( Block(-1.) );
+      }
+      A.rows[i].indices.push_back( i );
+      A.rows[i].blocks.push_back( Block(2.) );
+      if( i+1 < n )
+      {
+        A.rows[i].indices.push_back( i+1 );
+        A.rows[i].blocks.push_back( Block(-1.) );
+      }
+    }
+    return A;
+  }
+
+  using TriangleMassMatrix = Dune::FieldMatrix<double,3,3>;
+
+  TriangleMassMatrix triangleMassMatrix(double area)
+  {
+    TriangleMassMatrix M;
+    for( auto i = 0u; i < 3u; ++i )
+      for( auto j = 0u; j < 3u; ++j )
+        M[i][j] = ( i == j ? 2 : 1 ) * area / 12;
+    return M;
+  }
+}
+
+TEST(SpectralBounds,GershgorinJacobi)
+{
+  auto A = laplacian1d( 100 );
+
+  for( auto nThreads : { 1u, 4u } )
+  {
+    auto bounds = Dune::SpectralBounds::gershgorinJacobi( A, nThreads );
+    EXPECT_NEAR( bounds.first, 0, testAccuracy() );
+    EXPECT_NEAR( bounds.second, 2, testAccuracy() );
+  }
+}
+
+TEST(SpectralBounds,GershgorinJacobi_NonpositiveDiagonal)
+{
+  auto A = laplacian1d( 100 );
+  A.rows[42].blocks[1] = Block(0.);
+
+  EXPECT_THROW( Dune::SpectralBounds::gershgorinJacobi( A, 1 ), std::runtime_error );
+  EXPECT_THROW( Dune::SpectralBounds::gershgorinJacobi( A, 4 ), std::runtime_error );
+}
+
+TEST(SpectralBounds,ElementwiseJacobi)
+{
+  auto elementMatrices = std::vector<TriangleMassMatrix>();
+  for( auto i = 1u; i <= 100u; ++i )
+    elementMatrices.push_back( triangleMassMatrix( 1./i ) );
+
+  for( auto nThreads : { 1u, 4u } )
+  {
+    auto bounds = Dune::SpectralBounds::elementwiseJacobi( elementMatrices, nThreads );
+    EXPECT_NEAR( bounds.first, 0.5, testAccuracy() );
+    EXPECT_NEAR( bounds.second, 2, testAccuracy() );
+  }
+}
+
+TEST(SpectralBounds,ElementwiseJacobi_NonpositiveDiagonal)
+{
+  auto elementMatrices = std::vector<TriangleMassMatrix>( 10, triangleMassMatrix( 1 ) );
+  elementMatrices[7][2][2] = -1;
+
+  EXPECT_THROW( Dune::SpectralBounds::elementwiseJacobi( elementMatrices, 1 ), std::runtime_error );
+  EXPECT_THROW( Dune::SpectralBounds::elementwiseJacobi( elementMatrices, 4 ), std::runtime_error );
+}
+
+TEST(SpectralBounds,MassMatrixJacobi)
+{
+  auto triangle = Dune::SpectralBounds::massMatrixJacobi( Dune::MassMatrixElement::TriangleP1 );
+  auto elementwise = Dune::SpectralBounds::elementwiseJacobi( std::vector<TriangleMassMatrix>( 1, triangleMassMatrix( 1 ) ), 1 );
+  EXPECT_NEAR( triangle.first, elementwise.first, testAccuracy() );
+  EXPECT_NEAR( triangle.second, elementwise.second, testAccuracy() );
+
+  auto hexahedron = Dune::SpectralBounds::massMatrixJacobi( Dune::MassMatrixElement::HexahedronQ1 );
+  EXPECT_DOUBLE_EQ( hexahedron.first, 0.125 );
+  EXPECT_DOUBLE_EQ( hexahedron.second, 3.375 );
+
+  for( auto element : { Dune::MassMatrixElement::TetrahedronP1, Dune::MassMatrixElement::QuadrilateralQ1, Dune::MassMatrixElement::PrismP1,
+                        Dune::MassMatrixElement::TriangleP2, Dune::MassMatrixElement::TetrahedronP2 } )
+  {
+    auto bounds = Dune::SpectralBounds::massMatrixJacobi( element );
+    EXPECT_GT( bounds.first, 0 );
+    EXPECT_LT( bounds.first, 1 );
+    EXPECT_GT( bounds.second, 1 );
+  }
+}
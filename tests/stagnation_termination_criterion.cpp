@@ -0,0 +1,96 @@
+#include <gtest/gtest.h>
+
+#include "dune/istl/solvers.hh"
+#include "../generic_iterative_method.hh"
+#include "../residual_based_termination_criterion.hh"
+#include "../stagnation_termination_criterion.hh"
+
+#include "mock/step.hh"
+#include "mock/vector.hh"
+
+namespace
+{
+  using Criterion = Dune::KrylovTerminationCriterion::Stagnation< Dune::KrylovTerminationCriterion::ResidualBased<double> >;
+
+  struct TestStagnationTerminationCriterion : ::testing::Test
+  {
+    TestStagnationTerminationCriterion()
+      : terminationCriterion( 1e-6 )
+    {
+      terminationCriterion.connect(step);
+      terminationCriterion.init();
+      terminationCriterion.setStagnationWindow( 3, 0.5 );
+    }
+
+    Criterion terminationCriterion;
+    Dune::Mock::Step step;
+  };
+
+  // residual norm stagnates at 1e-3 after the first step
+  struct StagnatingStep : Dune::Mock::Step
+  {
+    void compute(Dune::Mock::Vector&, Dune::Mock::Vector&)
+    {
+      residualNorm_ = 1e-3;
+    }
+  };
+}
+
+
+TEST_F(TestStagnationTerminationCriterion, ForwardsUnderlyingCriterion)
+{
+  EXPECT_DOUBLE_EQ( terminationCriterion.relativeAccuracy(), 1e-6 );
+  step.residualNorm_ = 1e-7;
+  EXPECT_TRUE( static_cast<bool>(terminationCriterion) );
+  EXPECT_FALSE( terminationCriterion.stagnated() );
+}
+
+TEST_F(TestStagnationTerminationCriterion, DetectStagnation)
+{
+  for( auto residualNorm : { 0.5, 0.2, 0.1, 0.05 } )
+  {
+    step.residualNorm_ = residualNorm;
+    EXPECT_FALSE( static_cast<bool>(terminationCriterion) );
+  }
+
+  // 0.03 > 0.5 * 0.05 does not stagnate, but further reduction within the window of 3 steps is required
+  step.residualNorm_ = 0.03;
+  EXPECT_FALSE( static_cast<bool>(terminationCriterion) );
+  step.residualNorm_ = 0.04;
+  EXPECT_FALSE( static_cast<bool>(terminationCriterion) );
+  EXPECT_TRUE( static_cast<bool>(terminationCriterion) );
+  EXPECT_TRUE( terminationCriterion.stagnated() );
+
+  terminationCriterion.init();
+  EXPECT_FALSE( terminationCriterion.stagnated() );
+}
+
+TEST(StagnationTerminationCriterion, SolverStatus)
+{
+  auto iterativeMethod = Dune::makeGenericIterativeMethod( StagnatingStep(), Criterion( 1e-6 ) );
+  iterativeMethod.getTerminationCriterion().setStagnationWindow( 10 );
+  Dune::Mock::Vector x, b;
+
+  Dune::IterativeMethodResult result;
+  iterativeMethod.apply( x, b, result );
+  EXPECT_EQ( result.status, Dune::SolverStatus::Stagnated );
+  EXPECT_FALSE( result.converged );
+  EXPECT_EQ( result.iterations, 11 );
+
+  Dune::InverseOperatorResult res;
+  iterativeMethod.apply( x, b, res );
+  EXPECT_FALSE( res.converged );
+}
+
+TEST(StagnationTerminationCriterion, CopyKeepsStagnationWindow)
+{
+  auto criterion = Criterion( 1e-6 );
+  criterion.setStagnationWindow( 3 );
+  auto iterativeMethod = Dune::makeGenericIterativeMethod( StagnatingStep(), criterion );
+  Dune::Mock::Vector x, b;
+
+  Dune::IterativeMethodResult result;
+  iterativeMethod.apply( x, b, result );
+  EXPECT_EQ( result.status, Dune::SolverStatus::Stagnated );
+  EXPECT_EQ( result.iterations, 4 );
+}
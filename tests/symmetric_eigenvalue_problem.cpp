@@ -0,0 +1,59 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <vector>
+
+#include "../symmetric_eigenvalue_problem.hh"
+
+namespace
+{
+  inline double testAccuracy()
+  {
+    return 1e-12;
+  }
+}
+
+TEST(SymmetricEigenvalueProblem,Eigenvalues)
+{
+  // A = [ 4 1 ; 1 3 ]
+  auto A = std::vector<double>{ 4, 1, 1, 3 };
+  auto eigenvalues = Dune::symmetricEigenvalueProblem( A, 2 );
+
+  ASSERT_EQ( eigenvalues.size(), 2u );
+  EXPECT_NEAR( eigenvalues[0], (7-sqrt(5.))/2, testAccuracy() );
+  EXPECT_NEAR( eigenvalues[1], (7+sqrt(5.))/2, testAccuracy() );
+}
+
+TEST(SymmetricEigenvalueProblem,Eigenvectors)
+{
+  // A = [ 2 -1 0 ; -1 2 -1 ; 0 -1 2 ]
+  const auto A = std::vector<double>{ 2, -1, 0, -1, 2, -1, 0, -1, 2 };
+  auto B = A;
+  auto V = std::vector<double>{};
+  auto eigenvalues = Dune::symmetricEigenvalueProblem( B, 3, &V );
+
+  ASSERT_EQ( eigenvalues.size(), 3u );
+  EXPECT_NEAR( eigenvalues[0], 2-sqrt(2.), testAccuracy() );
+  EXPECT_NEAR( eigenvalues[1], 2, testAccuracy() );
+  EXPECT_NEAR( eigenvalues[2], 2+sqrt(2.), testAccuracy() );
+
+  ASSERT_EQ( V.size(), 9u );
+  for( auto k = 0u; k < 3u; ++k )
+  {
+    for( auto i = 0u; i < 3u; ++i )
+    {
+      auto Av = 0.;
+      for( auto j = 0u; j < 3u; ++j )
+        Av += A[i*3+j] * V[j*3+k];
+      EXPECT_NEAR( Av, eigenvalues[k] * V[i*3+k], testAccuracy() );
+    }
+
+    for( auto l = 0u; l < 3u; ++l )
+    {
+      auto vw = 0.;
+      for( auto i = 0u; i < 3u; ++i )
+        vw += V[i*3+k] * V[i*3+l];
+      EXPECT_NEAR( vw, k == l ? 1 : 0, testAccuracy() );
+    }
+  }
+}
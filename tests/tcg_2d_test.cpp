@@ -111,3 +111,47 @@ TEST_F(TestTCGSolver_2d,TwoSteps)
   ASSERT_DOUBLE_EQ( x.data_[0], 0.0909090909090909 );
   ASSERT_DOUBLE_EQ( x.data_[1], 0.6363636363636364 );
 }
+
+TEST_F(TestTCGSolver_2d,TrustRegionFirstStep)
+{
+  cg.getStep().setTrustRegionRadius(1);
+  auto x = initialGuess();
+  auto b = rightHandSide();
+
+  cg.apply(x,b);
+
+  // the first step, along the initial residual (-8,-3), leaves the trust region
+  EXPECT_TRUE( cg.getStep().trustRegionBoundaryReached() );
+  EXPECT_DOUBLE_EQ( cg.getStep().correctionNorm(), 1 );
+  EXPECT_DOUBLE_EQ( x.data_[0], 2 - 8/sqrt(73) );
+  EXPECT_DOUBLE_EQ( x.data_[1], 1 - 3/sqrt(73) );
+}
+
+TEST_F(TestTCGSolver_2d,TrustRegionSecondStep)
+{
+  cg.getStep().setTrustRegionRadius(1.9);
+  auto x = initialGuess();
+  auto b = rightHandSide();
+
+  cg.apply(x,b);
+
+  EXPECT_TRUE( cg.getStep().trustRegionBoundaryReached() );
+  auto correctionNorm = sqrt( (x.data_[0]-2)*(x.data_[0]-2) + (x.data_[1]-1)*(x.data_[1]-1) );
+  EXPECT_NEAR( correctionNorm, 1.9, 1e-12 );
+  EXPECT_NEAR( cg.getStep().correctionNorm(), 1.9, 1e-12 );
+}
+
+TEST_F(TestTCGSolver_2d,TrustRegionInactive)
+{
+  cg.getStep().setTrustRegionRadius(10);
+  auto x = initialGuess();
+  auto b = rightHandSide();
+
+  cg.apply(x,b);
+
+  EXPECT_FALSE( cg.getStep().trustRegionBoundaryReached() );
+  EXPECT_NEAR( x.data_[0], 1./11, 1e-12 );
+  EXPECT_NEAR( x.data_[1], 7./11, 1e-12 );
+  auto correctionNorm = sqrt( (x.data_[0]-2)*(x.data_[0]-2) + (x.data_[1]-1)*(x.data_[1]-1) );
+  EXPECT_NEAR( cg.getStep().correctionNorm(), correctionNorm, 1e-12 );
+}
@@ -0,0 +1,177 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cmath>
+#include <thread>
+#include <utility>
+
+#include "dune/istl/solvers.hh"
+#include "../generic_iterative_method.hh"
+#include "../residual_based_termination_criterion.hh"
+#include "../stagnation_termination_criterion.hh"
+#include "../termination_criterion_combinators.hh"
+
+#include "mock/step.hh"
+#include "mock/vector.hh"
+
+namespace
+{
+  using Dune::KrylovTerminationCriterion::ResidualBased;
+  using Dune::KrylovTerminationCriterion::IterationBudget;
+  using Dune::KrylovTerminationCriterion::WallClockBudget;
+
+  using AnyCriterion = Dune::KrylovTerminationCriterion::Any< ResidualBased<double>, IterationBudget<double> >;
+  using AllCriterion = Dune::KrylovTerminationCriterion::All< ResidualBased<double>, ResidualBased<double> >;
+
+  struct TestAnyTerminationCriterion : ::testing::Test
+  {
+    TestAnyTerminationCriterion()
+      : terminationCriterion( ResidualBased<double>(1e-6), IterationBudget<double>(3) )
+    {
+      terminationCriterion.connect(step);
+      terminationCriterion.init();
+    }
+
+    AnyCriterion terminationCriterion;
+    Dune::Mock::Step step;
+  };
+
+  // residual norm decreases by the factor 10 in each step
+  struct DecreasingStep : Dune::Mock::Step
+  {
+    void compute(Dune::Mock::Vector&, Dune::Mock::Vector&)
+    {
+      residualNorm_ *= 0.1;
+    }
+  };
+}
+
+
+TEST_F(TestAnyTerminationCriterion, ForwardsMixins)
+{
+  terminationCriterion.setRelativeAccuracy( 1e-3 );
+  EXPECT_DOUBLE_EQ( terminationCriterion.get<0>().relativeAccuracy(), 1e-3 );
+
+  auto copy = terminationCriterion;
+  EXPECT_DOUBLE_EQ( copy.relativeAccuracy(), 1e-3 );
+  copy.setRelativeAccuracy( 1e-4 );
+  EXPECT_DOUBLE_EQ( copy.get<0>().relativeAccuracy(), 1e-4 );
+  EXPECT_DOUBLE_EQ( terminationCriterion.get<0>().relativeAccuracy(), 1e-3 );
+}
+
+TEST_F(TestAnyTerminationCriterion, TerminatesIfPrimaryCriterionIsSatisfied)
+{
+  step.residualNorm_ = 1e-7;
+  EXPECT_TRUE( static_cast<bool>(terminationCriterion) );
+  EXPECT_FALSE( terminationCriterion.budgetExhausted() );
+  EXPECT_DOUBLE_EQ( terminationCriterion.errorEstimate(), 1e-7 );
+}
+
+TEST_F(TestAnyTerminationCriterion, TerminatesIfBudgetIsExhausted)
+{
+  step.residualNorm_ = 0.5;
+  EXPECT_FALSE( static_cast<bool>(terminationCriterion) );
+  EXPECT_FALSE( static_cast<bool>(terminationCriterion) );
+  EXPECT_TRUE( static_cast<bool>(terminationCriterion) );
+  EXPECT_TRUE( terminationCriterion.budgetExhausted() );
+
+  terminationCriterion.init();
+  EXPECT_FALSE( terminationCriterion.budgetExhausted() );
+  EXPECT_FALSE( static_cast<bool>(terminationCriterion) );
+}
+
+TEST(AllTerminationCriterion, RequiresAllCriteria)
+{
+  auto terminationCriterion = AllCriterion( ResidualBased<double>(1e-2), ResidualBased<double>(1e-4) );
+  Dune::Mock::Step step;
+  terminationCriterion.connect(step);
+  terminationCriterion.init();
+
+  step.residualNorm_ = 1e-3;
+  EXPECT_FALSE( static_cast<bool>(terminationCriterion) );
+  step.residualNorm_ = 1e-5;
+  EXPECT_TRUE( static_cast<bool>(terminationCriterion) );
+  EXPECT_FALSE( terminationCriterion.budgetExhausted() );
+}
+
+TEST(WallClockBudget, TerminatesAfterBudget)
+{
+  auto budget = WallClockBudget<double>( std::chrono::milliseconds(1), 2 );
+  budget.init();
+  std::this_thread::sleep_for( std::chrono::milliseconds(2) );
+  // the clock is only read in every second iteration
+  EXPECT_FALSE( static_cast<bool>(budget) );
+  EXPECT_TRUE( static_cast<bool>(budget) );
+  EXPECT_TRUE( budget.budgetExhausted() );
+  EXPECT_TRUE( std::isnan( budget.errorEstimate() ) );
+}
+
+TEST(AnyTerminationCriterion, SolverStatus)
+{
+  auto iterativeMethod = Dune::makeGenericIterativeMethod( DecreasingStep(), AnyCriterion( ResidualBased<double>(1e-6), IterationBudget<double>(3) ) );
+  Dune::Mock::Vector x, b;
+
+  Dune::IterativeMethodResult result;
+  iterativeMethod.apply( x, b, result );
+  EXPECT_EQ( result.status, Dune::SolverStatus::BudgetExhausted );
+  EXPECT_FALSE( result.converged );
+  EXPECT_EQ( result.iterations, 3 );
+
+  iterativeMethod.setRelativeAccuracy( 1e-2 );
+  iterativeMethod.apply( x, b, result );
+  EXPECT_EQ( result.status, Dune::SolverStatus::Converged );
+  EXPECT_TRUE( result.converged );
+}
+
+TEST(AnyTerminationCriterion, Assignment)
+{
+  auto iterativeMethod = Dune::makeGenericIterativeMethod( DecreasingStep(), AnyCriterion( ResidualBased<double>(1e-6), IterationBudget<double>(3) ) );
+  auto other = Dune::makeGenericIterativeMethod( DecreasingStep(), AnyCriterion( ResidualBased<double>(1e-2), IterationBudget<double>(3) ) );
+  iterativeMethod = other;
+  Dune::Mock::Vector x, b;
+
+  Dune::IterativeMethodResult result;
+  iterativeMethod.apply( x, b, result );
+  EXPECT_EQ( result.status, Dune::SolverStatus::Converged );
+
+  // the criteria of the assigned method are still connected to its mixins
+  iterativeMethod.setRelativeAccuracy( 1e-6 );
+  EXPECT_DOUBLE_EQ( iterativeMethod.getTerminationCriterion().get<0>().relativeAccuracy(), 1e-6 );
+  EXPECT_DOUBLE_EQ( other.getTerminationCriterion().get<0>().relativeAccuracy(), 1e-2 );
+  iterativeMethod.apply( x, b, result );
+  EXPECT_EQ( result.status, Dune::SolverStatus::BudgetExhausted );
+
+  iterativeMethod = std::move( other );
+  iterativeMethod.apply( x, b, result );
+  EXPECT_EQ( result.status, Dune::SolverStatus::Converged );
+}
+
+TEST(AllTerminationCriterion, Assignment)
+{
+  auto terminationCriterion = AllCriterion( ResidualBased<double>(1e-2), ResidualBased<double>(1e-4) );
+  auto other = AllCriterion( ResidualBased<double>(1e-1), ResidualBased<double>(1e-2) );
+  terminationCriterion = other;
+  Dune::Mock::Step step;
+  terminationCriterion.connect(step);
+  terminationCriterion.init();
+
+  step.residualNorm_ = 1e-3;
+  EXPECT_TRUE( static_cast<bool>(terminationCriterion) );
+
+  terminationCriterion.setRelativeAccuracy( 1e-4 );
+  EXPECT_DOUBLE_EQ( terminationCriterion.get<1>().relativeAccuracy(), 1e-4 );
+  EXPECT_FALSE( static_cast<bool>(terminationCriterion) );
+}
+
+TEST(AnyTerminationCriterion, ForwardsStagnation)
+{
+  using Criterion = Dune::KrylovTerminationCriterion::Any< Dune::KrylovTerminationCriterion::Stagnation< ResidualBased<double> >, IterationBudget<double> >;
+  auto iterativeMethod = Dune::makeGenericIterativeMethod( Dune::Mock::Step(), Criterion( 1e-6, IterationBudget<double>(100) ) );
+  iterativeMethod.getTerminationCriterion().get<0>().setStagnationWindow( 5 );
+  Dune::Mock::Vector x, b;
+
+  Dune::IterativeMethodResult result;
+  iterativeMethod.apply( x, b, result );
+  EXPECT_EQ( result.status, Dune::SolverStatus::Stagnated );
+  EXPECT_EQ( result.iterations, 6 );
+}